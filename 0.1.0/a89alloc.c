@@ -2,36 +2,316 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>  // UINT_MAX
+#include <time.h>
 #include "a89alloc.h"
 
-#define MAX_ALLOCATIONS 1000  // Configurável conforme necessidades
+#ifndef A89ALLOC_RELEASE
 
-typedef struct {
-    void* ptr;          // Ponteiro para a memória alocada
-    size_t size;        // Tamanho do bloco alocado em bytes
-    char file[256];     // Nome do arquivo onde ocorreu a alocação
-    int line;           // Número da linha da alocação
+/*
+ * Cada bloco é precedido por um cabeçalho com os dados da alocação.
+ * Os blocos vivos formam uma lista duplamente encadeada, de modo que
+ * alocar e liberar são O(1) e não há limite de alocações. O nome do
+ * arquivo é o próprio ponteiro de __FILE__ (literal estático), não uma
+ * cópia.
+ *
+ * a89free só lê o cabeçalho depois de achar o bloco no conjunto de
+ * blocos vivos: um ponteiro de malloc() ou já liberado nunca tem a
+ * memória antes dele lida.
+ */
+
+typedef union allocation_info {
+    struct {
+        union allocation_info* prev;  // Bloco vivo anterior
+        union allocation_info* next;  // Próximo bloco vivo
+        size_t size;        // Tamanho do bloco alocado em bytes
+        const char* file;   // Arquivo onde ocorreu a alocação (__FILE__)
+        int line;           // Número da linha da alocação
+        int site;           // Índice em profile_sites (-1 = sem perfil)
+        clock_t birth;      // Momento da alocação (só com perfil ativo)
+    } info;
+    long double align;      // Garante o alinhamento da memória do usuário
 } allocation_info;
 
-// Array principal de controle
-static allocation_info allocations[MAX_ALLOCATIONS];
+// Lista de blocos vivos, em ordem de alocação
+static allocation_info* first_allocation = NULL;
+static allocation_info* last_allocation = NULL;
 
 // Contador de alocações ativas
 static int total_allocations = 0;
 
+#define HEADER_OF(ptr) ((allocation_info*)(ptr) - 1)
+#define USER_PTR(header) ((void*)((header) + 1))
 
-void* a89alloc(size_t size, const char* file, int line) {
-    // Validação 1: Verificar limite de alocações
-    if (total_allocations >= MAX_ALLOCATIONS) {
-        fprintf(stderr,
-                "ERRO: Limite máximo de alocações atingido (%d)!\n", 
-                MAX_ALLOCATIONS);
-        fprintf(stderr,
-                "Considere aumentar MAX_ALLOCATIONS ou revisar o código.\n");
-        return NULL;
+
+//===================================================================
+// CONJUNTO DE BLOCOS VIVOS
+//===================================================================
+/*
+ * Tabela hash de endereçamento aberto com os cabeçalhos vivos, usando
+ * malloc direto como a tabela do perfil. A remoção desloca os vizinhos
+ * para trás (sem marcas de removido), então a busca para no primeiro
+ * slot vazio.
+ */
+#define LIVE_INITIAL_CAPACITY 1024
+
+static allocation_info** live_slots = NULL;
+static size_t live_capacity = 0;        // Potência de 2
+
+static size_t live_hash(const allocation_info* header) {
+    size_t key = (size_t)header >> 4;   // Blocos alinhados: bits baixos são zero
+    key ^= key >> 16;
+    key *= 0x45d9f3bu;
+    return key ^ (key >> 16);
+}
+
+static int live_grow(void) {
+    size_t new_capacity = live_capacity ? live_capacity * 2 : LIVE_INITIAL_CAPACITY;
+    allocation_info** slots = calloc(new_capacity, sizeof(allocation_info*));
+    if (slots == NULL) return 0;
+
+    for (size_t i = 0; i < live_capacity; i++) {
+        if (live_slots[i] == NULL) continue;
+        size_t slot = live_hash(live_slots[i]) & (new_capacity - 1);
+        while (slots[slot] != NULL) slot = (slot + 1) & (new_capacity - 1);
+        slots[slot] = live_slots[i];
     }
-    
-    // Validação 2: Verificar tamanho válido
+    free(live_slots);
+    live_slots = slots;
+    live_capacity = new_capacity;
+    return 1;
+}
+
+static int live_insert(allocation_info* header) {
+    if ((size_t)total_allocations >= live_capacity / 2 && !live_grow()) {
+        return 0;
+    }
+
+    size_t slot = live_hash(header) & (live_capacity - 1);
+    while (live_slots[slot] != NULL) slot = (slot + 1) & (live_capacity - 1);
+    live_slots[slot] = header;
+    return 1;
+}
+
+// Remove o bloco do conjunto; retorna 0 se ele não estava vivo
+static int live_remove(const allocation_info* header) {
+    if (live_capacity == 0) return 0;
+    size_t mask = live_capacity - 1;
+
+    size_t hole = live_hash(header) & mask;
+    while (live_slots[hole] != header) {
+        if (live_slots[hole] == NULL) return 0;
+        hole = (hole + 1) & mask;
+    }
+
+    // Traz para o buraco os blocos cuja posição ideal fica antes dele
+    for (size_t next = (hole + 1) & mask; live_slots[next] != NULL; next = (next + 1) & mask) {
+        size_t home = live_hash(live_slots[next]) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            live_slots[hole] = live_slots[next];
+            hole = next;
+        }
+    }
+    live_slots[hole] = NULL;
+    return 1;
+}
+
+
+//===================================================================
+// PERFIL DE ALOCAÇÕES
+//===================================================================
+/*
+ * Com o perfil ativo, cada local de alocação (file:line) acumula número
+ * de chamadas, bytes, pico de bytes vivos e tempo de vida dos blocos.
+ * Os locais ficam em uma tabela hash de endereçamento aberto indexada
+ * pelo ponteiro de __FILE__ e pela linha; a tabela usa malloc direto
+ * para não aparecer nos próprios relatórios.
+ */
+#define PROFILE_INITIAL_CAPACITY 256
+#define STR_LOCATION_SIZE 64
+
+typedef struct {
+    const char* file;
+    int line;
+    unsigned long count;        // Chamadas a a89alloc
+    unsigned long frees;        // Blocos já liberados
+    size_t total_bytes;         // Bytes alocados no total
+    size_t live_bytes;          // Bytes ainda vivos
+    size_t peak_live_bytes;     // Maior valor de live_bytes
+    double lifetime_total;      // Soma dos tempos de vida (segundos)
+} profile_site;
+
+static int profiling = 0;
+static profile_site* profile_sites = NULL;
+static int profile_site_count = 0;
+static int* profile_buckets = NULL;     // Índice em profile_sites ou -1
+static int profile_capacity = 0;        // Potência de 2
+
+static unsigned int profile_hash(const char* file, int line) {
+    size_t key = (size_t)file ^ ((size_t)line * 2654435761u);
+    return (unsigned int)(key ^ (key >> 16));
+}
+
+static int profile_grow(void) {
+    int new_capacity = profile_capacity ? profile_capacity * 2 : PROFILE_INITIAL_CAPACITY;
+    profile_site* sites = realloc(profile_sites, (size_t)new_capacity / 2 * sizeof(profile_site));
+    int* buckets = malloc((size_t)new_capacity * sizeof(int));
+    if (sites == NULL || buckets == NULL) {
+        if (sites != NULL) profile_sites = sites;
+        free(buckets);
+        return 0;
+    }
+    profile_sites = sites;
+
+    for (int i = 0; i < new_capacity; i++) buckets[i] = -1;
+    for (int i = 0; i < profile_site_count; i++) {
+        unsigned int b = profile_hash(sites[i].file, sites[i].line) & (new_capacity - 1);
+        while (buckets[b] != -1) b = (b + 1) & (new_capacity - 1);
+        buckets[b] = i;
+    }
+    free(profile_buckets);
+    profile_buckets = buckets;
+    profile_capacity = new_capacity;
+    return 1;
+}
+
+// Retorna o índice do local (criando-o se necessário) ou -1
+static int profile_site_for(const char* file, int line) {
+    if (profile_site_count >= profile_capacity / 2 && !profile_grow()) {
+        return -1;
+    }
+
+    unsigned int b = profile_hash(file, line) & (profile_capacity - 1);
+    while (profile_buckets[b] != -1) {
+        profile_site* site = &profile_sites[profile_buckets[b]];
+        if (site->file == file && site->line == line) return profile_buckets[b];
+        b = (b + 1) & (profile_capacity - 1);
+    }
+
+    profile_site* site = &profile_sites[profile_site_count];
+    memset(site, 0, sizeof(*site));
+    site->file = file;
+    site->line = line;
+    profile_buckets[b] = profile_site_count;
+    return profile_site_count++;
+}
+
+static void profile_alloc(allocation_info* header) {
+    header->info.site = profile_site_for(header->info.file, header->info.line);
+    if (header->info.site < 0) return;
+
+    profile_site* site = &profile_sites[header->info.site];
+    site->count++;
+    site->total_bytes += header->info.size;
+    site->live_bytes += header->info.size;
+    if (site->live_bytes > site->peak_live_bytes) {
+        site->peak_live_bytes = site->live_bytes;
+    }
+    header->info.birth = clock();
+}
+
+static void profile_free(allocation_info* header) {
+    profile_site* site = &profile_sites[header->info.site];
+    site->frees++;
+    site->live_bytes -= header->info.size;
+    site->lifetime_total += (double)(clock() - header->info.birth) / CLOCKS_PER_SEC;
+}
+
+// Ordena por bytes totais e, em caso de empate, por número de chamadas
+static int compare_sites(const void* a, const void* b) {
+    const profile_site* sa = (const profile_site*)a;
+    const profile_site* sb = (const profile_site*)b;
+    if (sa->total_bytes != sb->total_bytes) return sa->total_bytes < sb->total_bytes ? 1 : -1;
+    if (sa->count != sb->count) return sa->count < sb->count ? 1 : -1;
+    return 0;
+}
+
+// Cópia ordenada dos locais (a tabela original continua indexada)
+static profile_site* sorted_sites(void) {
+    if (profile_site_count == 0) return NULL;
+    profile_site* sorted = malloc((size_t)profile_site_count * sizeof(profile_site));
+    if (sorted == NULL) return NULL;
+    memcpy(sorted, profile_sites, (size_t)profile_site_count * sizeof(profile_site));
+    qsort(sorted, (size_t)profile_site_count, sizeof(profile_site), compare_sites);
+    return sorted;
+}
+
+static double average_lifetime_us(const profile_site* site) {
+    return site->frees ? site->lifetime_total * 1e6 / site->frees : 0.0;
+}
+
+void a89profile_start(void) {
+    profiling = 1;
+}
+
+void a89profile_stop(void) {
+    profiling = 0;
+}
+
+void a89profile_report(void) {
+    printf("PERFIL DE ALOCAÇÕES POR LOCAL\n");
+    for (int i = 0; i < 100; i++) printf("=");
+    printf("\n");
+
+    if (profile_site_count == 0) {
+        printf("Nenhuma alocação registrada%s.\n",
+               profiling ? "" : " (perfil desativado)");
+        return;
+    }
+
+    profile_site* sorted = sorted_sites();
+    if (sorted == NULL) {
+        fprintf(stderr, "ERRO: Falha de memória ao ordenar o perfil\n");
+        return;
+    }
+
+    unsigned long total_count = 0;
+    size_t total_bytes = 0;
+
+    printf("%-28s %10s %12s %12s %12s %10s %14s\n",
+           "Local", "Chamadas", "Bytes", "Pico vivo", "Vivos", "Liberados", "Vida média(us)");
+    for (int i = 0; i < profile_site_count; i++) {
+        const profile_site* site = &sorted[i];
+        char location[STR_LOCATION_SIZE];
+        snprintf(location, sizeof(location), "%s:%d", site->file, site->line);
+        printf("%-28s %10lu %12zu %12zu %12zu %10lu %14.2f\n",
+               location, site->count, site->total_bytes, site->peak_live_bytes,
+               site->live_bytes, site->frees, average_lifetime_us(site));
+        total_count += site->count;
+        total_bytes += site->total_bytes;
+    }
+
+    for (int i = 0; i < 100; i++) printf("-");
+    printf("\n");
+    printf("Total: %lu alocações, %zu bytes (%.2f KB) em %d locais\n",
+           total_count, total_bytes, (double)total_bytes / 1024.0, profile_site_count);
+
+    free(sorted);
+}
+
+int a89profile_write_csv(const char* filename) {
+    FILE* out = fopen(filename, "w");
+    if (out == NULL) {
+        fprintf(stderr, "ERRO: Não foi possível criar '%s'\n", filename);
+        return 0;
+    }
+
+    profile_site* sorted = sorted_sites();
+    fprintf(out, "file,line,count,total_bytes,peak_live_bytes,live_bytes,frees,avg_lifetime_us\n");
+    for (int i = 0; sorted != NULL && i < profile_site_count; i++) {
+        const profile_site* site = &sorted[i];
+        fprintf(out, "%s,%d,%lu,%zu,%zu,%zu,%lu,%.3f\n",
+                site->file, site->line, site->count, site->total_bytes,
+                site->peak_live_bytes, site->live_bytes, site->frees,
+                average_lifetime_us(site));
+    }
+    free(sorted);
+
+    return fclose(out) == 0;
+}
+
+
+void* a89alloc(size_t size, const char* file, int line) {
+    // Validação 1: Verificar tamanho válido
     if (size == 0) {
         fprintf(stderr,
                 "AVISO: Tentativa de alocar 0 bytes em %s:%d\n", 
@@ -41,42 +321,58 @@ void* a89alloc(size_t size, const char* file, int line) {
         return NULL;
     }
     
-    // Validação 3: Verificar parâmetros de entrada
+    // Validação 2: Verificar parâmetros de entrada
     if (file == NULL) {
         fprintf(stderr,
                 "ERRO: Parâmetro 'file' é NULL em a89alloc()\n");
         return NULL;
     }
     
-    // Alocação usando malloc padrão
-    void* ptr = malloc(size);
+    // Alocação usando malloc padrão (cabeçalho + dados)
+    allocation_info* header = NULL;
+    if (size <= (size_t)-1 - sizeof(allocation_info)) {
+        header = malloc(sizeof(allocation_info) + size);
+    }
     
-    if (ptr != NULL) {
-        // Registro bem-sucedido no sistema de controle
-        allocations[total_allocations].ptr = ptr;
-        allocations[total_allocations].size = size;
-        
-        // Cópia segura do nome do arquivo
-        strncpy(allocations[total_allocations].file, file, 255);
-        // Encerra a string corretamente
-        allocations[total_allocations].file[255] = '\0';
-        
-        allocations[total_allocations].line = line;
-        total_allocations++;
-        
-        // Log informativo (pode ser desabilitado em produção)
-        //printf("ALOCAÇÃO: %zu bytes em %s:%d (ptr: %p)\n", 
-        //       size, file, line, ptr);
-    } else {
+    if (header == NULL) {
         // Tratamento de falha na alocação
         fprintf(stderr,
                 "ERRO: Falha na alocação de %zu bytes em %s:%d\n", 
                 size, file, line);
         fprintf(stderr,
                 "Possíveis causas: memória insuficiente ou fragmentação.\n");
+        return NULL;
+    }
+
+    if (!live_insert(header)) {
+        fprintf(stderr,
+                "ERRO: Falha ao registrar a alocação de %zu bytes em %s:%d\n",
+                size, file, line);
+        free(header);
+        return NULL;
     }
+
+    // Registro no sistema de controle: inserção no fim da lista
+    header->info.size = size;
+    header->info.file = file;
+    header->info.line = line;
+    header->info.site = -1;
+    if (profiling) profile_alloc(header);
+    header->info.next = NULL;
+    header->info.prev = last_allocation;
+    if (last_allocation != NULL) {
+        last_allocation->info.next = header;
+    } else {
+        first_allocation = header;
+    }
+    last_allocation = header;
+    total_allocations++;
+    
+    // Log informativo (pode ser desabilitado em produção)
+    //printf("ALOCAÇÃO: %zu bytes em %s:%d (ptr: %p)\n", 
+    //       size, file, line, USER_PTR(header));
     
-    return ptr;
+    return USER_PTR(header);
 }
 
 
@@ -86,29 +382,36 @@ void a89free(void* ptr) {
         return;
     }
     
-    // Busca linear no array de alocações
-    for (int i = 0; i < total_allocations; i++) {
-        if (allocations[i].ptr == ptr) {
-            // Alocação encontrada - proceder com liberação da memória
-            free(ptr);
-            
-            // Otimização: substituir por último elemento (O(1) vs O(n))
-            allocations[i] = allocations[total_allocations - 1];
-            total_allocations--;
-            
-            return;
-        }
+    allocation_info* header = HEADER_OF(ptr);
+
+    // Só o endereço é usado até o bloco ser achado entre os vivos
+    if (!live_remove(header)) {
+        fprintf(stderr, "AVISO: Tentativa de liberar ponteiro não rastreado: %p\n", ptr);
+        fprintf(stderr, "         Possíveis causas:\n");
+        fprintf(stderr, "         - Ponteiro alocado com malloc() padrão\n");
+        fprintf(stderr, "         - Double-free (liberação dupla)\n");
+        fprintf(stderr, "         - Ponteiro corrompido\n");
+
+        // Decisão: não liberar - em um double-free, free() corromperia o heap
+        return;
     }
-    
-    // Ponteiro não encontrado - possível erro
-    fprintf(stderr, "AVISO: Tentativa de liberar ponteiro não rastreado: %p\n", ptr);
-    fprintf(stderr, "         Possíveis causas:\n");
-    fprintf(stderr, "         - Ponteiro alocado com malloc() padrão\n");
-    fprintf(stderr, "         - Double-free (liberação dupla)\n");
-    fprintf(stderr, "         - Ponteiro corrompido\n");
-    
-    // Decisão: liberar mesmo assim para evitar vazamentos
-    free(ptr);
+
+    // Remove o bloco da lista de blocos vivos
+    if (header->info.prev != NULL) {
+        header->info.prev->info.next = header->info.next;
+    } else {
+        first_allocation = header->info.next;
+    }
+    if (header->info.next != NULL) {
+        header->info.next->info.prev = header->info.prev;
+    } else {
+        last_allocation = header->info.prev;
+    }
+    total_allocations--;
+
+    if (header->info.site >= 0) profile_free(header);
+
+    free(header);
 }
 
 
@@ -131,19 +434,20 @@ void a89check_leaks(void) {
     
     size_t total_leaked = 0;
     size_t max_leak = 0;
-    int max_leak_index = 0;
+    allocation_info* max_leak_block = first_allocation;
     
     // Análise detalhada de cada vazamento
-    for (int i = 0; i < total_allocations; i++) {
-        printf("VAZAMENTO #%d:\n", i + 1);
-        printf("  Localização: %s:%d\n", allocations[i].file, allocations[i].line);
-        printf("  Tamanho: %zu bytes\n", allocations[i].size);
-        printf("  Endereço: %p\n", allocations[i].ptr);
+    int number = 1;
+    for (allocation_info* block = first_allocation; block != NULL; block = block->info.next, number++) {
+        printf("VAZAMENTO #%d:\n", number);
+        printf("  Localização: %s:%d\n", block->info.file, block->info.line);
+        printf("  Tamanho: %zu bytes\n", block->info.size);
+        printf("  Endereço: %p\n", USER_PTR(block));
         
         // Análise de impacto
-        if (allocations[i].size > 1024) {
+        if (block->info.size > 1024) {
             printf("  IMPACTO ALTO: Vazamento > 1KB\n");
-        } else if (allocations[i].size > 100) {
+        } else if (block->info.size > 100) {
             printf("  IMPACTO MÉDIO: Vazamento > 100 bytes\n");
         }
         
@@ -154,10 +458,10 @@ void a89check_leaks(void) {
         printf("\n");
         
         // Estatísticas
-        total_leaked += allocations[i].size;
-        if (allocations[i].size > max_leak) {
-            max_leak = allocations[i].size;
-            max_leak_index = i;
+        total_leaked += block->info.size;
+        if (block->info.size > max_leak) {
+            max_leak = block->info.size;
+            max_leak_block = block;
         }
     }
     
@@ -168,8 +472,8 @@ void a89check_leaks(void) {
     printf("  Média por vazamento: %.2f bytes\n", 
            (double)total_leaked / total_allocations);
     printf("  Maior vazamento: %zu bytes em %s:%d\n",
-           max_leak, allocations[max_leak_index].file, 
-           allocations[max_leak_index].line);
+           max_leak, max_leak_block->info.file, 
+           max_leak_block->info.line);
     
     // Recomendações
     printf("\nRECOMENDAÇÕES:\n");
@@ -208,17 +512,18 @@ void a89report_alloc(void) {
     size_t max_alloc = 0;
     
     // Processamento de cada alocação
-    for (int i = 0; i < total_allocations; i++) {
-        printf("\nALOCAÇÃO #%d:\n", i + 1);
-        printf("  Tamanho: %zu bytes\n", allocations[i].size);
-        printf("  Endereço: %p\n", allocations[i].ptr);
-        printf("  Arquivo: %s\n", allocations[i].file);
-        printf("  Linha: %d\n", allocations[i].line);
+    int number = 1;
+    for (allocation_info* block = first_allocation; block != NULL; block = block->info.next, number++) {
+        printf("\nALOCAÇÃO #%d:\n", number);
+        printf("  Tamanho: %zu bytes\n", block->info.size);
+        printf("  Endereço: %p\n", USER_PTR(block));
+        printf("  Arquivo: %s\n", block->info.file);
+        printf("  Linha: %d\n", block->info.line);
         
         // Estatísticas globais
-        total_memory += allocations[i].size;
-        if (allocations[i].size < min_alloc) min_alloc = allocations[i].size;
-        if (allocations[i].size > max_alloc) max_alloc = allocations[i].size;
+        total_memory += block->info.size;
+        if (block->info.size < min_alloc) min_alloc = block->info.size;
+        if (block->info.size > max_alloc) max_alloc = block->info.size;
     }
     
     // Resumo estatístico
@@ -237,4 +542,41 @@ void a89report_alloc(void) {
     printf("\n");
 }
 
+#else // A89ALLOC_RELEASE
+
+/*
+ * Build de release: A89ALLOC e a89free viram malloc/free (ver
+ * a89alloc.h). Os relatórios continuam existindo para que o código
+ * que os chama compile sem alterações.
+ */
+void* a89alloc(size_t size, const char* file, int line) {
+    (void)file; (void)line;
+    return malloc(size);
+}
+
+void a89check_leaks(void) {
+    printf("a89alloc: rastreamento desativado (A89ALLOC_RELEASE)\n");
+}
+
+void a89report_alloc(void) {
+    printf("a89alloc: rastreamento desativado (A89ALLOC_RELEASE)\n");
+}
+
+void a89profile_start(void) {
+}
+
+void a89profile_stop(void) {
+}
+
+void a89profile_report(void) {
+    printf("a89alloc: rastreamento desativado (A89ALLOC_RELEASE)\n");
+}
+
+int a89profile_write_csv(const char* filename) {
+    (void)filename;
+    return 0;
+}
+
+#endif // A89ALLOC_RELEASE
+
 // fim de a89alloc.c
@@ -2,6 +2,17 @@
 #define A89ALLOC_H
 
 #include <stddef.h>
+#include <stdlib.h>
+
+/********************************************************************
+Rastreamento
+Por padrão cada bloco carrega um cabeçalho com tamanho, arquivo e
+linha da alocação; alocar e liberar são O(1) e não há limite no número
+de alocações.
+
+Compilando com -DA89ALLOC_RELEASE o rastreamento é removido:
+A89ALLOC e a89free viram malloc e free diretos.
+********************************************************************/
 
 /********************************************************************
 Função principal de alocação com rastreamento
@@ -20,7 +31,11 @@ void* a89alloc(size_t size, const char* file, int line);
 Macro para facilitar o uso da função a89alloc
 Captura automaticamente __FILE__ e __LINE__
 ********************************************************************/
+#ifdef A89ALLOC_RELEASE
+#define A89ALLOC(size) malloc(size)
+#else
 #define A89ALLOC(size) a89alloc(size, __FILE__, __LINE__)
+#endif
 
 
 /********************************************************************
@@ -28,7 +43,11 @@ Função para liberação de memória com rastreamento
 Parâmetro:
 	ptr - ponteiro a ser liberado
 ********************************************************************/
+#ifdef A89ALLOC_RELEASE
+#define a89free(ptr) free(ptr)
+#else
 void a89free(void* ptr);
+#endif
 
 /********************************************************************
 Função para verificar vazamentos de memória
@@ -42,4 +61,19 @@ Função para gerar relatório de alocações ativas
 ********************************************************************/
 void a89report_alloc(void);
 
+/********************************************************************
+Perfil de alocações
+Depois de a89profile_start(), cada local de alocação (arquivo:linha)
+acumula: número de chamadas, bytes totais, pico de bytes vivos, bytes
+ainda vivos e tempo de vida médio dos blocos liberados.
+
+a89profile_report()    - tabela ordenada por bytes totais (stdout)
+a89profile_write_csv() - mesmos dados em CSV, para comparar execuções;
+                         retorna 1 em caso de sucesso
+********************************************************************/
+void a89profile_start(void);
+void a89profile_stop(void);
+void a89profile_report(void);
+int a89profile_write_csv(const char* filename);
+
 #endif // A89ALLOC_H
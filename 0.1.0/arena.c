@@ -0,0 +1,71 @@
+#include <stdlib.h>
+
+#include "arena.h"
+#include "a89alloc.h"
+
+#define ARENA_ALIGN(size) (((size) + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+// Os dados começam logo após o cabeçalho, já alinhados
+#define ARENA_HEADER_SIZE ARENA_ALIGN(sizeof(ArenaBlock))
+#define ARENA_DATA(block) ((unsigned char*)(block) + ARENA_HEADER_SIZE)
+
+void arena_init(Arena* arena, size_t block_size) {
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size > 0 ? block_size : ARENA_BLOCK_SIZE;
+}
+
+static ArenaBlock* arena_new_block(size_t size) {
+    ArenaBlock* block = (ArenaBlock*)A89ALLOC(ARENA_HEADER_SIZE + size);
+    if (block == NULL) return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = ARENA_ALIGN(size > 0 ? size : 1);
+
+    ArenaBlock* block = arena->current;
+    if (block != NULL && block->size - block->used >= size) {
+        void* ptr = ARENA_DATA(block) + block->used;
+        block->used += size;
+        return ptr;
+    }
+
+    // Reaproveita o próximo bloco mantido por arena_reset(), se couber
+    ArenaBlock* next = (block != NULL) ? block->next : arena->first;
+    if (next == NULL || next->size < size) {
+        ArenaBlock* fresh = arena_new_block(size > arena->block_size ? size : arena->block_size);
+        if (fresh == NULL) return NULL;
+        fresh->next = next;
+        if (block != NULL) {
+            block->next = fresh;
+        } else {
+            arena->first = fresh;
+        }
+        next = fresh;
+    }
+
+    next->used = size;
+    arena->current = next;
+    return ARENA_DATA(next);
+}
+
+void arena_reset(Arena* arena) {
+    arena->current = NULL;
+    // O primeiro bloco volta a ser usado no próximo arena_alloc
+    // (used é zerado quando o bloco é reativado)
+}
+
+void arena_free(Arena* arena) {
+    ArenaBlock* block = arena->first;
+    while (block != NULL) {
+        ArenaBlock* next = block->next;
+        a89free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+}
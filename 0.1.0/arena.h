@@ -0,0 +1,42 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/********************************************************************
+ARENA (ALOCADOR BUMP-POINTER)
+
+Os nós da AST de um parse são alocados em sequência dentro de blocos
+grandes. Nada é liberado individualmente: arena_reset() devolve tudo
+de uma vez e mantém os blocos para o próximo parse, de modo que um
+REPL em regime não faz novas alocações.
+********************************************************************/
+
+#define ARENA_BLOCK_SIZE (64 * 1024)    // Tamanho padrão de cada bloco
+#define ARENA_ALIGNMENT 8               // Alinhamento dos ponteiros devolvidos (double/ponteiro)
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;            // Bytes úteis do bloco
+    size_t used;            // Bytes já entregues
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* first;      // Primeiro bloco (NULL = arena vazia)
+    ArenaBlock* current;    // Bloco onde as alocações estão sendo feitas
+    size_t block_size;      // Tamanho dos novos blocos
+} Arena;
+
+// Inicializa a arena (não aloca nada até o primeiro arena_alloc)
+void arena_init(Arena* arena, size_t block_size);
+
+// Aloca size bytes alinhados; retorna NULL em caso de falha
+void* arena_alloc(Arena* arena, size_t size);
+
+// Libera todas as alocações de uma vez, mantendo os blocos
+void arena_reset(Arena* arena);
+
+// Devolve os blocos ao sistema
+void arena_free(Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,151 @@
+/*
+ * BENCHMARK DE LISTAS LONGAS DE ARGUMENTOS - RUDIS
+ *
+ * Monta mean(v1, v2, ..., vN) com N literais e mede, para N crescente,
+ * o custo por argumento de cada etapa:
+ * - parse (lexer + parser, incluindo o array de argumentos);
+ * - evaluate() (AST) e compile_ast() + vm_execute() (bytecode);
+ * - optimize_ast(), que calcula a chamada uma vez (mean é pura).
+ * Com crescimento geométrico o custo por argumento fica estável; uma
+ * cópia a cada argumento faria o custo crescer com N.
+ *
+ * Para compilar, troque main.c por bench_args.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "parser.h"
+#include "evaluator.h"
+#include "optimizer.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "a89alloc.h"
+
+#define BENCH_MAX_ARGS 100000
+#define BENCH_ROUNDS 20
+#define LITERAL_SIZE 16
+
+static unsigned long long bench_seed = 88172645463325252ull;
+
+static unsigned long long next_random(void) {
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 7;
+    bench_seed ^= bench_seed << 17;
+    return bench_seed;
+}
+
+// "mean(12.34, 5.67, ...)" com count literais; expected recebe a média
+static char* build_call(int count, double* expected) {
+    char* source = A89ALLOC((size_t)count * LITERAL_SIZE + 16);
+    int used = sprintf(source, "mean(");
+    double sum = 0.0;
+
+    for (int i = 0; i < count; i++) {
+        unsigned long long r = next_random();
+        unsigned long long whole = (r >> 8) % 10000;
+        unsigned long long cents = (r >> 40) % 100;
+        int literal = used + (i ? 2 : 0);
+        used += sprintf(source + used, "%s%llu.%02llu", i ? ", " : "", whole, cents);
+        sum += strtod(source + literal, NULL);
+    }
+    strcpy(source + used, ")");
+    *expected = sum / count;
+    return source;
+}
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void run(int count) {
+    double expected;
+    char* source = build_call(count, &expected);
+
+    Arena arena;
+    arena_init(&arena, ARENA_BLOCK_SIZE);
+    EvaluatorState state;
+    evaluator_init(&state);
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    // Parse
+    ASTNode* ast = NULL;
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        if (ast != NULL) {
+            free_ast(ast);
+            arena_reset(&arena);
+        }
+        Lexer lexer;
+        lexer_init(&lexer, source);
+        ast = parse(&lexer, &arena);
+        if (ast == NULL) {
+            printf("Falha no parse com %d argumentos\n", count);
+            exit(1);
+        }
+    }
+    double parse_seconds = elapsed(start);
+
+    // Avaliação da AST
+    double result = 0.0;
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        EvaluatorResult evaluated = evaluate(&state, ast);
+        if (!evaluated.success) {
+            printf("Erro na avaliação: %s\n", state.error.message);
+            exit(1);
+        }
+        result = VALUE_AS_DOUBLE(evaluated.value);
+    }
+    double evaluate_seconds = elapsed(start);
+
+    // Bytecode
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        if (!compile_ast(&chunk, ast)) {
+            printf("Falha na compilação com %d argumentos\n", count);
+            exit(1);
+        }
+        EvaluatorResult executed = vm_execute(&state, &chunk);
+        if (!executed.success || VALUE_AS_DOUBLE(executed.value) != result) {
+            printf("VM diferente da AST com %d argumentos\n", count);
+            exit(1);
+        }
+    }
+    double vm_seconds = elapsed(start);
+
+    // Pré-cálculo da chamada constante
+    start = clock();
+    optimize_ast(&state, &arena, ast);
+    double optimize_seconds = elapsed(start);
+    if (ast->type != NODE_NUMBER || VALUE_AS_DOUBLE(ast->as.value) != result) {
+        printf("optimize_ast não calculou a chamada com %d argumentos\n", count);
+        exit(1);
+    }
+
+    double per_arg = 1e9 / ((double)count * BENCH_ROUNDS);
+    printf("%7d  %8.1f  %8.1f  %10.1f  %8.1f  %s\n", count,
+           parse_seconds * per_arg, evaluate_seconds * per_arg, vm_seconds * per_arg,
+           optimize_seconds * 1e9 / count,
+           fabs(result - expected) <= 1e-9 * fabs(expected) ? "ok" : "DIFERENTE");
+
+    chunk_free(&chunk);
+    free_ast(ast);
+    arena_free(&arena);
+    evaluator_free(&state);
+    a89free(source);
+}
+
+int main() {
+    printf("=== BENCHMARK: mean() com muitos argumentos ===\n");
+    printf("ns por argumento (média de %d execuções)\n", BENCH_ROUNDS);
+    printf("   args     parse  evaluate  compile+vm  optimize  média\n");
+    for (int count = 1000; count <= BENCH_MAX_ARGS; count *= 10) {
+        run(count);
+    }
+    return 0;
+}
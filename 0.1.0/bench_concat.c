@@ -0,0 +1,108 @@
+/*
+ * BENCHMARK DA CONCATENAÇÃO EM CADEIA - RUDIS
+ *
+ * Mede p0 + p1 + ... + p(k-1), com texto e números alternados (como em
+ * linha = nome + ": " + qtd + " x " + preco), para vários k:
+ * - do jeito antigo, um string_concatenate() por '+', copiando o lado
+ *   esquerdo acumulado a cada passo (O(k²) bytes);
+ * - com concatenate_values(), o caminho de NODE_CONCAT / OP_CONCAT,
+ *   que aloca uma vez e copia cada operando uma vez.
+ *
+ * Para compilar, troque main.c por bench_concat.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "evaluator.h"
+#include "a89alloc.h"
+
+#define BENCH_BYTES 200000000L     // Bytes de resultado por medição
+#define MAX_PARTS 1024
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Esquerda para a direita, um '+' de cada vez
+static Value pairwise(const Value* parts, int count) {
+    EvaluatorResult left = create_success_result(value_retain(parts[0]), 0);
+    for (int i = 1; i < count; i++) {
+        EvaluatorResult right = create_success_result(parts[i], 0);
+        EvaluatorResult concat = string_concatenate(&left, &right, -1);
+        value_release(&left.value);
+        left = concat;
+    }
+    return left.value;
+}
+
+// Como a VM: os operandos são cópias na pilha, soltas depois
+static Value gathered(const Value* parts, int count, Value* scratch) {
+    for (int i = 0; i < count; i++) {
+        scratch[i] = value_retain(parts[i]);
+    }
+    Value concat = concatenate_values(scratch, count, -1);
+    for (int i = 0; i < count; i++) {
+        value_release(&scratch[i]);
+    }
+    return concat;
+}
+
+int main() {
+    static const int counts[] = { 4, 16, 64, 256, 1024 };
+    static Value parts[MAX_PARTS];
+    static Value scratch[MAX_PARTS];
+    long checksum = 0;
+
+    for (int i = 0; i < MAX_PARTS; i++) {
+        parts[i] = (i % 2 == 0) ? create_string_value("coluna ") : create_number_value(i);
+    }
+
+    printf("=== BENCHMARK: cadeia de k operandos com '+' ===\n");
+    printf("%6s  %12s  %12s  %8s  %6s\n", "k", "par a par", "em uma vez", "ganho", "bytes");
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int count = counts[c];
+
+        Value sample = gathered(parts, count, scratch);
+        Value check = pairwise(parts, count);
+        int length = value_length(&sample);
+        if (length != value_length(&check) ||
+            memcmp(value_string(&sample), value_string(&check), length) != 0) {
+            printf("Resultados diferentes para k = %d\n", count);
+            return 1;
+        }
+        value_release(&sample);
+        value_release(&check);
+
+        long rounds = BENCH_BYTES / length;
+        if (rounds > 2000000) rounds = 2000000;
+
+        clock_t start = clock();
+        for (long r = 0; r < rounds; r++) {
+            Value result = pairwise(parts, count);
+            checksum += value_length(&result);
+            value_release(&result);
+        }
+        double pairwise_seconds = elapsed(start);
+
+        start = clock();
+        for (long r = 0; r < rounds; r++) {
+            Value result = gathered(parts, count, scratch);
+            checksum += value_length(&result);
+            value_release(&result);
+        }
+        double gathered_seconds = elapsed(start);
+
+        printf("%6d  %9.0f ns  %9.0f ns  %7.1fx  %6d\n", count,
+               pairwise_seconds * 1e9 / rounds, gathered_seconds * 1e9 / rounds,
+               pairwise_seconds / gathered_seconds, length);
+    }
+    printf("Checksum: %ld\n", checksum);
+
+    for (int i = 0; i < MAX_PARTS; i++) {
+        value_release(&parts[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * BENCHMARK DO AVALIADOR - RUDIS
+ *
+ * Mede o custo por nó de evaluate() sobre uma expressão aritmética
+ * profunda: ((((1 + 2) * 3 - 4) / 5 + 6) * 7 ...)
+ *
+ * Para compilar, troque main.c por bench_evaluator.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "parser.h"
+#include "evaluator.h"
+#include "a89alloc.h"
+
+#define BENCH_TERMS 400         // Operandos na expressão
+#define BENCH_ITERATIONS 20000  // Avaliações da mesma AST
+
+// Monta "((((1 + 2) * 3 - 4) / 5 ..." com BENCH_TERMS operandos
+static char* build_expression(int terms) {
+    const char ops[] = "+*-/";
+    size_t size = (size_t)terms * 16 + 16;
+    char* buffer = (char*)A89ALLOC(size);
+    size_t used = 0;
+
+    for (int i = 1; i < terms; i++) {
+        buffer[used++] = '(';
+    }
+    used += snprintf(buffer + used, size - used, "1");
+    for (int i = 2; i <= terms; i++) {
+        used += snprintf(buffer + used, size - used, " %c %d)",
+                         ops[i % 4], (i % 9) + 1);
+    }
+    return buffer;
+}
+
+static int count_nodes(ASTNode* node) {
+    ASTWalk walk;
+    int leaving;
+    int count = 0;
+
+    ast_walk_begin(&walk, node);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (!leaving) count++;
+    }
+    ast_walk_end(&walk);
+    return count;
+}
+
+int main() {
+    char* source = build_expression(BENCH_TERMS);
+
+    Arena arena;
+    arena_init(&arena, ARENA_BLOCK_SIZE);
+
+    Lexer lexer;
+    lexer_init(&lexer, source);
+    ASTNode* ast = parse(&lexer, &arena);
+    if (ast == NULL) {
+        printf("Falha no parse da expressão\n");
+        return 1;
+    }
+
+    EvaluatorState state;
+    evaluator_init(&state);
+    resolve_variables(&state, ast);
+
+    int nodes = count_nodes(ast);
+    double checksum = 0.0;
+
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        EvaluatorResult result = evaluate(&state, ast);
+        if (!result.success) {
+            printf("Erro na avaliação\n");
+            return 1;
+        }
+        checksum += VALUE_AS_DOUBLE(result.value);
+        value_release(&result.value);
+    }
+    clock_t end = clock();
+
+    double seconds = (double)(end - start) / CLOCKS_PER_SEC;
+    double evaluated = (double)nodes * BENCH_ITERATIONS;
+
+    printf("=== BENCHMARK: evaluate() em expressão profunda ===\n");
+    printf("sizeof(EvaluatorResult): %zu bytes\n", sizeof(EvaluatorResult));
+    printf("sizeof(Value):           %zu bytes\n", sizeof(Value));
+    printf("Nós na AST:              %d\n", nodes);
+    printf("Avaliações:              %d\n", BENCH_ITERATIONS);
+    printf("Tempo total:             %.3f s\n", seconds);
+    printf("Custo por nó:            %.2f ns\n", seconds * 1e9 / evaluated);
+    printf("Checksum:                %g\n", checksum);
+
+    free_ast(ast);
+    arena_free(&arena);
+    evaluator_free(&state);
+    a89free(source);
+    return 0;
+}
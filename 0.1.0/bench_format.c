@@ -0,0 +1,103 @@
+/*
+ * BENCHMARK DA FORMATAÇÃO DE NÚMEROS - RUDIS
+ *
+ * Compara snprintf (o caminho usado antes por print_value e
+ * number_to_string_value) com format_number_fixed() e
+ * format_number_shortest() sobre valores típicos de relatórios:
+ * preços, resultados de divisões, inteiros grandes e empates de
+ * arredondamento (0.125 com 2 casas). Também confere que:
+ * - o formato fixo é idêntico ao de printf("%.*f");
+ * - o formato mais curto volta ao mesmo double com strtod.
+ *
+ * Para compilar, troque main.c por bench_format.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "numfmt.h"
+#include "a89alloc.h"
+
+#define BENCH_VALUES 1000000
+#define BENCH_DECIMALS 2
+
+static unsigned long long bench_seed = 88172645463325252ull;
+
+static unsigned long long next_random(void) {
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 7;
+    bench_seed ^= bench_seed << 17;
+    return bench_seed;
+}
+
+static double random_value(void) {
+    unsigned long long r = next_random();
+    double sign = (r & 1) ? -1.0 : 1.0;
+    switch ((r >> 1) % 5) {
+        case 0:  return sign * (double)((r >> 8) % 10000000) / 100.0;         // Preço
+        case 1:  return sign * (double)((r >> 8) % 1000) / 7.0;               // Divisão
+        case 2:  return sign * (double)((r >> 8) % 100000000000ull);          // Inteiro > 2^31
+        case 3:  return sign * (double)((r >> 8) % 100000) / 8.0;             // Empates (.125, .375...)
+        default: return sign * (double)(r >> 11) / 9007199254740992.0 * 1e6; // 17 dígitos
+    }
+}
+
+int main() {
+    double* values = A89ALLOC(sizeof(double) * BENCH_VALUES);
+    char buffer[NUMBER_BUFFER_SIZE];
+    char expected[NUMBER_BUFFER_SIZE];
+    long bytes = 0;
+
+    for (int i = 0; i < BENCH_VALUES; i++) values[i] = random_value();
+
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        bytes += snprintf(buffer, sizeof(buffer), "%.*f", BENCH_DECIMALS, values[i]);
+    }
+    double snprintf_fixed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        bytes += format_number_fixed(buffer, values[i], BENCH_DECIMALS);
+    }
+    double fast_fixed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        bytes += snprintf(buffer, sizeof(buffer), "%.17g", values[i]);
+    }
+    double snprintf_shortest = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        bytes += format_number_shortest(buffer, values[i]);
+    }
+    double fast_shortest = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Conferências
+    int fixed_mismatches = 0;
+    int roundtrip_failures = 0;
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        for (int places = 0; places <= 15; places += 5) {
+            snprintf(expected, sizeof(expected), "%.*f", places, values[i]);
+            format_number_fixed(buffer, values[i], places);
+            if (strcmp(buffer, expected) != 0) fixed_mismatches++;
+        }
+        format_number_shortest(buffer, values[i]);
+        if (strtod(buffer, NULL) != values[i]) roundtrip_failures++;
+    }
+
+    printf("=== BENCHMARK: formatação de números ===\n");
+    printf("Valores:                       %d\n", BENCH_VALUES);
+    printf("snprintf(\"%%.%df\"):              %6.1f ns/número\n", BENCH_DECIMALS, snprintf_fixed * 1e9 / BENCH_VALUES);
+    printf("format_number_fixed:           %6.1f ns/número\n", fast_fixed * 1e9 / BENCH_VALUES);
+    printf("snprintf(\"%%.17g\"):              %6.1f ns/número\n", snprintf_shortest * 1e9 / BENCH_VALUES);
+    printf("format_number_shortest:        %6.1f ns/número\n", fast_shortest * 1e9 / BENCH_VALUES);
+    printf("Fixo diferente de printf:      %d (casas 0, 5, 10, 15)\n", fixed_mismatches);
+    printf("Mais curto sem ida e volta:    %d\n", roundtrip_failures);
+    printf("Bytes escritos:                %ld\n", bytes);
+
+    a89free(values);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * BENCHMARK DO LEXER - RUDIS
+ *
+ * Mede a vazão de lexer_get_next_token() (MB/s e tokens/s) sobre um
+ * script sintético com identificadores, funções, números, strings e
+ * comentários, como os scripts gerados que o Rudis executa.
+ *
+ * Para compilar, troque main.c por bench_lexer.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "a89alloc.h"
+
+#define BENCH_SOURCE_SIZE (8 * 1024 * 1024)    // Bytes do script
+#define BENCH_ROUNDS 5                          // Passadas sobre o script
+
+static const char* bench_lines[] = {
+    "taxa_mensal = (1 + 0.05) ^ (1 / 12) - 1\n",
+    "valor_presente = pv(taxa_mensal, 360, 1500.75) # financiamento\n",
+    "media = mean(12.5, 13.25, 14, 15.125, 16.0625, 17)\n",
+    "relatorio = \"Total: \" + left(12, \"R$ 1.234,56\") + \" ok\"\n",
+    "mascara = 0xFF + 0b1010 * contador_de_linhas_processadas\n",
+    "// comentário de linha inteira com algum texto\n",
+    "x1 = sqrt(x0 * x0 + y0 * y0); y1 = abs(x1 - 3.14159265358979)\n",
+};
+
+// Repete as linhas acima até BENCH_SOURCE_SIZE bytes
+static char* build_source(size_t* out_size) {
+    int line_count = (int)(sizeof(bench_lines) / sizeof(bench_lines[0]));
+    char* source = (char*)A89ALLOC(BENCH_SOURCE_SIZE + 256);
+    size_t used = 0;
+
+    for (int i = 0; used < BENCH_SOURCE_SIZE; i++) {
+        const char* line = bench_lines[i % line_count];
+        size_t len = strlen(line);
+        memcpy(source + used, line, len);
+        used += len;
+    }
+    source[used] = '\0';
+    *out_size = used;
+    return source;
+}
+
+int main() {
+    size_t size = 0;
+    char* source = build_source(&size);
+
+    long tokens = 0;
+    double checksum = 0.0;
+
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        Lexer lexer;
+        lexer_init(&lexer, source);
+
+        Token token;
+        do {
+            token = lexer_get_next_token(&lexer);
+            if (token.type == TOKEN_ERROR) {
+                printf("Erro do lexer na posição %d\n", token.position);
+                return 1;
+            }
+            checksum += token.value + token.position;
+            tokens++;
+        } while (token.type != TOKEN_EOF);
+    }
+    clock_t end = clock();
+
+    double seconds = (double)(end - start) / CLOCKS_PER_SEC;
+    double megabytes = (double)size * BENCH_ROUNDS / (1024.0 * 1024.0);
+
+    printf("=== BENCHMARK: lexer ===\n");
+    printf("sizeof(Token):      %zu bytes\n", sizeof(Token));
+    printf("Script:             %.1f MB x %d passadas\n", (double)size / (1024.0 * 1024.0), BENCH_ROUNDS);
+    printf("Tokens:             %ld\n", tokens);
+    printf("Tempo total:        %.3f s\n", seconds);
+    printf("Vazão:              %.1f MB/s\n", megabytes / seconds);
+    printf("Tokens por segundo: %.1f M\n", tokens / seconds / 1e6);
+    printf("Checksum:           %g\n", checksum);
+
+    a89free(source);
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * BENCHMARK DOS LITERAIS NUMÉRICOS - RUDIS
+ *
+ * Gera um arquivo de dados só com números (preços, medidas, taxas com
+ * muitas casas) e mede:
+ * - a vazão do lexer sobre o arquivo inteiro;
+ * - o custo de lexer_str_to_double() por literal, comparado com strtod();
+ * - quantos literais não saem bit a bit iguais ao strtod() (que
+ *   arredonda corretamente).
+ *
+ * Para compilar, troque main.c por bench_numbers.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "a89alloc.h"
+
+#define BENCH_LITERALS 1000000
+#define BENCH_ROUNDS 5
+#define LITERAL_SIZE 32
+
+// Gerador simples (xorshift) para o arquivo ser sempre o mesmo
+static unsigned long long bench_seed = 88172645463325252ull;
+
+static unsigned long long next_random(void) {
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 7;
+    bench_seed ^= bench_seed << 17;
+    return bench_seed;
+}
+
+// Um literal no estilo dos arquivos de dados: 1234.56, 0.000731, 42...
+static void random_literal(char* buffer) {
+    unsigned long long r = next_random();
+    switch (r % 4) {
+        case 0:     // Preço com 2 casas
+            snprintf(buffer, LITERAL_SIZE, "%llu.%02llu", (r >> 8) % 1000000, (r >> 40) % 100);
+            break;
+        case 1:     // Taxa pequena
+            snprintf(buffer, LITERAL_SIZE, "0.%06llu", (r >> 8) % 1000000);
+            break;
+        case 2:     // Medida com 15 dígitos significativos
+            snprintf(buffer, LITERAL_SIZE, "%llu.%09llu", (r >> 8) % 1000000, (r >> 24) % 1000000000);
+            break;
+        default:    // Inteiro
+            snprintf(buffer, LITERAL_SIZE, "%llu", (r >> 8) % 100000000);
+            break;
+    }
+}
+
+int main() {
+    char (*literals)[LITERAL_SIZE] = A89ALLOC(sizeof(*literals) * BENCH_LITERALS);
+    char* source = A89ALLOC((size_t)BENCH_LITERALS * (LITERAL_SIZE + 1));
+    size_t size = 0;
+
+    for (int i = 0; i < BENCH_LITERALS; i++) {
+        random_literal(literals[i]);
+        size_t len = strlen(literals[i]);
+        memcpy(source + size, literals[i], len);
+        size += len;
+        source[size++] = (i % 8 == 7) ? '\n' : ',';
+    }
+    source[size] = '\0';
+
+    // Vazão do lexer sobre o arquivo de dados
+    long tokens = 0;
+    double checksum = 0.0;
+    clock_t start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        Lexer lexer;
+        lexer_init(&lexer, source);
+        Token token;
+        do {
+            token = lexer_get_next_token(&lexer);
+            checksum += token.value;
+            tokens++;
+        } while (token.type != TOKEN_EOF && token.type != TOKEN_ERROR);
+    }
+    double lex_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Conversão isolada: lexer_str_to_double x strtod
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_LITERALS; i++) {
+            checksum += lexer_str_to_double(literals[i]);
+        }
+    }
+    double lexer_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_LITERALS; i++) {
+            checksum += strtod(literals[i], NULL);
+        }
+    }
+    double strtod_seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_LITERALS; i++) {
+        double a = lexer_str_to_double(literals[i]);
+        double b = strtod(literals[i], NULL);
+        if (memcmp(&a, &b, sizeof(double)) != 0) mismatches++;
+    }
+
+    double conversions = (double)BENCH_LITERALS * BENCH_ROUNDS;
+    printf("=== BENCHMARK: literais numéricos ===\n");
+    printf("Arquivo:               %.1f MB, %d literais\n", size / (1024.0 * 1024.0), BENCH_LITERALS);
+    printf("Lexer:                 %.1f MB/s (%ld tokens)\n",
+           size * BENCH_ROUNDS / (1024.0 * 1024.0) / lex_seconds, tokens);
+    printf("lexer_str_to_double:   %.1f ns/literal\n", lexer_seconds * 1e9 / conversions);
+    printf("strtod:                %.1f ns/literal\n", strtod_seconds * 1e9 / conversions);
+    printf("Diferentes do strtod:  %d de %d\n", mismatches, BENCH_LITERALS);
+    printf("Checksum:              %g\n", checksum);
+
+    a89free(source);
+    a89free(literals);
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * BENCHMARK DA SAÍDA BUFERIZADA - RUDIS
+ *
+ * Grava BENCH_LINES linhas no formato de print(i, "item", x) em um
+ * arquivo temporário e compara:
+ * - o caminho antigo (uma chamada de stdio por valor e por separador)
+ *   com o stdio em modo linha, como em terminais e pseudo-terminais;
+ * - o mesmo caminho com o stdio em blocos (pipe comum);
+ * - print_value() + output.c, que grava o buffer inteiro de uma vez.
+ * O arquivo gerado pelos três precisa ser o mesmo.
+ *
+ * Para compilar, troque main.c por bench_output.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "value.h"
+#include "numfmt.h"
+#include "output.h"
+#include "a89alloc.h"
+
+#define BENCH_LINES 1000000
+#define BENCH_FILE "bench_output.tmp"
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Um print() do jeito antigo: fwrite por valor, printf por separador
+static void stdio_print(FILE* file, Value* values, int count) {
+    for (int i = 0; i < count; i++) {
+        if (values[i].type == VAL_NUMBER) {
+            char buffer[NUMBER_BUFFER_SIZE];
+            int length = format_number_fixed(buffer, values[i].as.number, 6);
+            fwrite(buffer, 1, length, file);
+        } else {
+            fwrite(value_string(&values[i]), 1, value_length(&values[i]), file);
+        }
+        if (i < count - 1) fprintf(file, " ");
+    }
+    fprintf(file, "\n");
+}
+
+static double run_stdio(int mode) {
+    FILE* file = fopen(BENCH_FILE, "wb");
+    if (file == NULL) {
+        printf("Não foi possível criar %s\n", BENCH_FILE);
+        exit(1);
+    }
+    setvbuf(file, NULL, mode, BUFSIZ);
+
+    Value values[3];
+    values[1] = create_string_value("item");
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        values[0] = create_number_value(i);
+        values[2] = create_number_value(i + 0.5);
+        stdio_print(file, values, 3);
+    }
+    fclose(file);
+    double seconds = elapsed(start);
+    value_release(&values[1]);
+    return seconds;
+}
+
+static double run_output(void) {
+    if (!output_open_file(BENCH_FILE)) {
+        printf("Não foi possível criar %s\n", BENCH_FILE);
+        exit(1);
+    }
+
+    Value values[3];
+    values[1] = create_string_value("item");
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_LINES; i++) {
+        values[0] = create_number_value(i);
+        values[2] = create_number_value(i + 0.5);
+        for (int j = 0; j < 3; j++) {
+            print_value(values[j], 6);
+            if (j < 2) output_char(' ');
+        }
+        output_char('\n');
+        output_statement_end();
+    }
+    output_close();
+    double seconds = elapsed(start);
+    value_release(&values[1]);
+    return seconds;
+}
+
+// Conteúdo do arquivo temporário (liberar com a89free)
+static char* read_result(long* size) {
+    FILE* file = fopen(BENCH_FILE, "rb");
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    rewind(file);
+    char* data = A89ALLOC((size_t)*size + 1);
+    *size = (long)fread(data, 1, (size_t)*size, file);
+    fclose(file);
+    return data;
+}
+
+int main() {
+    long line_size, block_size, output_size;
+
+    double line_seconds = run_stdio(_IOLBF);
+    char* line_data = read_result(&line_size);
+    double block_seconds = run_stdio(_IOFBF);
+    char* block_data = read_result(&block_size);
+    double output_seconds = run_output();
+    char* output_data = read_result(&output_size);
+    remove(BENCH_FILE);
+
+    int same = line_size == output_size && block_size == output_size &&
+               memcmp(line_data, output_data, output_size) == 0 &&
+               memcmp(block_data, output_data, output_size) == 0;
+
+    printf("=== BENCHMARK: saída de print() ===\n");
+    printf("%d linhas, %.1f MB\n", BENCH_LINES, output_size / (1024.0 * 1024.0));
+    printf("stdio em modo linha:   %6.1f ns/linha\n", line_seconds * 1e9 / BENCH_LINES);
+    printf("stdio em blocos:       %6.1f ns/linha\n", block_seconds * 1e9 / BENCH_LINES);
+    printf("output.c:              %6.1f ns/linha (%.1fx o modo linha)\n",
+           output_seconds * 1e9 / BENCH_LINES, line_seconds / output_seconds);
+    printf("Arquivos iguais:       %s\n", same ? "sim" : "NÃO");
+
+    a89free(line_data);
+    a89free(block_data);
+    a89free(output_data);
+    return 0;
+}
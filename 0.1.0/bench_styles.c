@@ -0,0 +1,87 @@
+/*
+ * BENCHMARK DOS ESTILOS - RUDIS
+ *
+ * Mede bold(cyan(texto)) com o texto já pronto (como em
+ * print(bold(cyan(repeat("=", 50))))):
+ * - do jeito antigo, copiando o texto com os códigos em volta a cada
+ *   função de estilo;
+ * - com o estilo nos campos do Value (sem cópia), como em value.c.
+ * Também compara quantos bytes cada forma manda para um terminal.
+ *
+ * Para compilar, troque main.c por bench_styles.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "value.h"
+#include "a89alloc.h"
+
+#define BENCH_CALLS 2000000
+#define TEXT_WIDTH 50
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// O apply_ansi() antigo: código + texto + RESET em uma string nova
+static Value copy_ansi(Value text, const char* ansi_code) {
+    int code_len = (int)strlen(ansi_code);
+    int text_len = value_length(&text);
+    int reset_len = (int)strlen(RESET);
+
+    Value result;
+    char* data = create_string_buffer(&result, code_len + text_len + reset_len);
+    memcpy(data, ansi_code, code_len);
+    memcpy(data + code_len, value_string(&text), text_len);
+    memcpy(data + code_len + text_len, RESET, reset_len);
+    return result;
+}
+
+int main() {
+    Value fill = create_string_value("=");
+    Value width = create_number_value(TEXT_WIDTH);
+    Value text = repeat(fill, width);
+    long checksum = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        Value inner = copy_ansi(text, CYAN);
+        Value outer = copy_ansi(inner, BOLD);
+        checksum += value_length(&outer);
+        value_release(&inner);
+        value_release(&outer);
+    }
+    double copy_seconds = elapsed(start);
+
+    Value copied_inner = copy_ansi(text, CYAN);
+    Value copied = copy_ansi(copied_inner, BOLD);
+    int copied_bytes = value_length(&copied);
+
+    start = clock();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        Value inner = cyan(text);
+        Value outer = bold(inner);
+        checksum += outer.attributes + outer.foreground;
+        value_release(&inner);
+        value_release(&outer);
+    }
+    double style_seconds = elapsed(start);
+
+    // Bytes no terminal: ESC[1;36m + texto + ESC[0m
+    int styled_bytes = (int)strlen("\033[1;36m") + TEXT_WIDTH + (int)strlen(RESET);
+
+    printf("=== BENCHMARK: bold(cyan(texto de %d bytes)) ===\n", TEXT_WIDTH);
+    printf("Cópia por estilo:   %6.1f ns/chamada, %d bytes na saída\n",
+           copy_seconds * 1e9 / BENCH_CALLS, copied_bytes);
+    printf("Estilo no Value:    %6.1f ns/chamada, %d bytes na saída\n",
+           style_seconds * 1e9 / BENCH_CALLS, styled_bytes);
+    printf("Checksum:           %ld\n", checksum);
+
+    value_release(&copied_inner);
+    value_release(&copied);
+    value_release(&text);
+    value_release(&fill);
+    return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * BENCHMARK DE TABELAS - RUDIS
+ *
+ * Monta um script no estilo de teste2.rudis com BENCH_ROWS linhas de
+ * produtos (nomes com acentos, guardados em variáveis e alinhados de
+ * novo a cada linha) e mede:
+ * - o script inteiro (parse, VM e saída para um arquivo temporário),
+ *   com as linhas montadas por left() + center() + right() e com
+ *   printf("%-24s%^10s%15s\n", ...), que escreve direto na saída;
+ * - value_display_width() com a largura guardada na string, contra
+ *   percorrer o texto a cada alinhamento.
+ * No fim confere se todas as linhas da tabela têm a mesma largura na
+ * tela e se as duas formas geram o mesmo arquivo.
+ *
+ * Para compilar, troque main.c por bench_table.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "parser.h"
+#include "evaluator.h"
+#include "optimizer.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "output.h"
+#include "width.h"
+#include "a89alloc.h"
+
+#define BENCH_ROWS 100000
+#define BENCH_WIDTH_CALLS 10000000
+#define BENCH_FILE "bench_table.tmp"
+#define BENCH_PRINTF_FILE "bench_table_printf.tmp"
+#define ROW_WIDTH 49        // left(24) + center(10) + right(15)
+#define LINE_SIZE 96
+
+static const char* product_names[] = {
+    "Caneta esferográfica", "Caderno universitário", "Borracha branca",
+    "Água mineral sem gás", "Pão de açúcar", "Café torrado e moído",
+    "Feijão carioca", "Maçã fuji",
+};
+#define PRODUCT_COUNT ((int)(sizeof(product_names) / sizeof(product_names[0])))
+
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Cabeçalho, variáveis p0..p7 e BENCH_ROWS linhas de dados
+static char* build_script(int use_printf, int* size) {
+    size_t capacity = (size_t)(BENCH_ROWS + 64) * LINE_SIZE;
+    char* script = A89ALLOC(capacity);
+    int used = 0;
+
+    used += sprintf(script + used, "print(bold(cyan(repeat(\"=\", %d))))\n", ROW_WIDTH);
+    used += sprintf(script + used, "print(center(%d, bold(blue(\"TABELA DE PRODUTOS\"))))\n", ROW_WIDTH);
+    used += sprintf(script + used, "print(left(24, \"PRODUTO\") + center(10, \"QTD\") + right(15, \"PREÇO\"))\n");
+    for (int i = 0; i < PRODUCT_COUNT; i++) {
+        used += sprintf(script + used, "p%d = \"%s\"\n", i, product_names[i]);
+    }
+    for (int row = 0; row < BENCH_ROWS; row++) {
+        const char* row_format = use_printf
+            ? "printf(\"%%-24s%%^10s%%15s\\n\", p%d, \"%d\", \"%d.%02d\")\n"
+            : "print(left(24, p%d) + center(10, \"%d\") + right(15, \"%d.%02d\"))\n";
+        used += sprintf(script + used, row_format,
+                        row % PRODUCT_COUNT, row % 500, row % 1000, row % 100);
+    }
+    *size = used;
+    return script;
+}
+
+static void run_script(const char* script, int size) {
+    EvaluatorState state;
+    evaluator_init(&state);
+    Arena arena;
+    arena_init(&arena, ARENA_BLOCK_SIZE);
+    Chunk chunk;
+    chunk_init(&chunk);
+
+    Lexer lexer;
+    Parser parser;
+    lexer_init_buffer(&lexer, script, size);
+    parser_init(&parser, &lexer);
+    parser.arena = &arena;
+
+    while (1) {
+        while (parser.current_token.type == TOKEN_NEWLINE) parser_advance(&parser);
+        if (parser.current_token.type == TOKEN_EOF) break;
+
+        ASTNode* ast = parse_line(&parser);
+        if (parser.has_error || ast == NULL) {
+            printf("Erro de sintaxe: %s\n", parser.error_message);
+            exit(1);
+        }
+        optimize_ast(&state, &arena, ast);
+        resolve_variables(&state, ast);
+        if (!compile_ast(&chunk, ast)) {
+            printf("Falha na compilação\n");
+            exit(1);
+        }
+        EvaluatorResult result = vm_execute(&state, &chunk);
+        if (!result.success) {
+            printf("Erro: %s\n", state.error.message);
+            exit(1);
+        }
+        value_release(&result.value);
+        chunk_reset(&chunk);
+        free_ast(ast);
+        arena_reset(&arena);
+    }
+
+    chunk_free(&chunk);
+    arena_free(&arena);
+    evaluator_free(&state);
+}
+
+// Roda o script com a saída no arquivo file_name; devolve os segundos
+static double run_to_file(int use_printf, const char* file_name) {
+    int size;
+    char* script = build_script(use_printf, &size);
+
+    if (!output_open_file(file_name)) {
+        printf("Não foi possível criar %s\n", file_name);
+        exit(1);
+    }
+    clock_t start = clock();
+    run_script(script, size);
+    output_close();
+    double seconds = elapsed(start);
+
+    a89free(script);
+    return seconds;
+}
+
+// Quantas linhas da tabela (depois do título) fogem de ROW_WIDTH colunas
+static int misaligned_rows(const char* file_name) {
+    FILE* file = fopen(file_name, "rb");
+    char line[LINE_SIZE * 2];
+    int count = 0;
+    int number = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        int length = (int)strcspn(line, "\n");
+        if (++number > 2 && text_display_width(line, length) != ROW_WIDTH) count++;
+    }
+    fclose(file);
+    return count;
+}
+
+// 1 se os dois arquivos têm o mesmo conteúdo
+static int same_files(const char* first, const char* second) {
+    FILE* a = fopen(first, "rb");
+    FILE* b = fopen(second, "rb");
+    int same = 1;
+    int c;
+
+    do {
+        c = fgetc(a);
+        if (c != fgetc(b)) same = 0;
+    } while (same && c != EOF);
+    fclose(a);
+    fclose(b);
+    return same;
+}
+
+int main() {
+    double concat_seconds = run_to_file(0, BENCH_FILE);
+    double printf_seconds = run_to_file(1, BENCH_PRINTF_FILE);
+    int misaligned = misaligned_rows(BENCH_FILE) + misaligned_rows(BENCH_PRINTF_FILE);
+    int same = same_files(BENCH_FILE, BENCH_PRINTF_FILE);
+    remove(BENCH_FILE);
+    remove(BENCH_PRINTF_FILE);
+
+    // Largura guardada x recalculada, nos mesmos nomes
+    Value names[PRODUCT_COUNT];
+    for (int i = 0; i < PRODUCT_COUNT; i++) {
+        names[i] = create_string_value(product_names[i]);
+    }
+    long checksum = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_WIDTH_CALLS; i++) {
+        const Value* name = &names[i % PRODUCT_COUNT];
+        checksum += text_display_width(value_string(name), value_length(name));
+    }
+    double scan_seconds = elapsed(start);
+
+    start = clock();
+    for (int i = 0; i < BENCH_WIDTH_CALLS; i++) {
+        checksum += value_display_width(&names[i % PRODUCT_COUNT]);
+    }
+    double cached_seconds = elapsed(start);
+
+    printf("=== BENCHMARK: tabela com %d linhas ===\n", BENCH_ROWS);
+    printf("left + center + right: %.3f s (%.1f ns/linha)\n",
+           concat_seconds, concat_seconds * 1e9 / BENCH_ROWS);
+    printf("printf:                %.3f s (%.1f ns/linha)\n",
+           printf_seconds, printf_seconds * 1e9 / BENCH_ROWS);
+    printf("Linhas desalinhadas:   %d\n", misaligned);
+    printf("Mesma saída:           %s\n", same ? "sim" : "NÃO");
+    printf("Largura recalculada:   %5.1f ns/chamada\n", scan_seconds * 1e9 / BENCH_WIDTH_CALLS);
+    printf("Largura guardada:      %5.1f ns/chamada\n", cached_seconds * 1e9 / BENCH_WIDTH_CALLS);
+    printf("Checksum:              %ld\n", checksum);
+
+    for (int i = 0; i < PRODUCT_COUNT; i++) {
+        value_release(&names[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * BENCHMARK DA VM - RUDIS
+ *
+ * Compara evaluate() (percurso da AST) com vm_execute() (bytecode) no
+ * mesmo script aritmético. O script é analisado e compilado uma vez
+ * e executado BENCH_ITERATIONS vezes, como o corpo de um laço.
+ *
+ * Para compilar, troque main.c por bench_vm.c em sources.txt.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lexer.h"
+#include "parser.h"
+#include "evaluator.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "a89alloc.h"
+
+#define BENCH_ITERATIONS 200000
+
+static const char* bench_script =
+    "a = 1.5; b = 2.25; c = 3; d = 0.5; "
+    "x = (a * b + c / d - (a - b) ^ 2) * 0.25 + a; "
+    "y = x * x - 2 * x * b + b * b - (c - d) * (c + d) / 4; "
+    "z = (x + y) * (x - y) / (1 + a * a) + (c % 2) * d; "
+    "w = -x + y * 3 - z / 7 + (a + b + c + d) * (a - d) ^ 2; "
+    "x * y + z * w - (x + y + z + w) / 4";
+
+typedef struct {
+    double seconds;
+    double checksum;
+} BenchTime;
+
+static BenchTime run_ast(EvaluatorState* state, ASTNode* ast) {
+    BenchTime time = { 0.0, 0.0 };
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        EvaluatorResult result = evaluate(state, ast);
+        if (!result.success) {
+            printf("Erro na avaliação: %s\n", state->error.message);
+            exit(1);
+        }
+        time.checksum += VALUE_AS_DOUBLE(result.value);
+        value_release(&result.value);
+    }
+    time.seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return time;
+}
+
+static BenchTime run_vm(EvaluatorState* state, const Chunk* chunk) {
+    BenchTime time = { 0.0, 0.0 };
+    clock_t start = clock();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        EvaluatorResult result = vm_execute(state, chunk);
+        if (!result.success) {
+            printf("Erro na VM: %s\n", state->error.message);
+            exit(1);
+        }
+        time.checksum += VALUE_AS_DOUBLE(result.value);
+        value_release(&result.value);
+    }
+    time.seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return time;
+}
+
+int main() {
+    Arena arena;
+    arena_init(&arena, ARENA_BLOCK_SIZE);
+
+    Lexer lexer;
+    lexer_init(&lexer, bench_script);
+    ASTNode* ast = parse(&lexer, &arena);
+    if (ast == NULL) {
+        printf("Falha no parse do script\n");
+        return 1;
+    }
+
+    EvaluatorState state;
+    evaluator_init(&state);
+    resolve_variables(&state, ast);
+
+    Chunk chunk;
+    chunk_init(&chunk);
+    if (!compile_ast(&chunk, ast)) {
+        printf("Falha na compilação do script\n");
+        return 1;
+    }
+
+    BenchTime ast_time = run_ast(&state, ast);
+    BenchTime vm_time = run_vm(&state, &chunk);
+
+    printf("=== BENCHMARK: AST x BYTECODE ===\n");
+    printf("Instruções (palavras):   %d\n", chunk.count);
+    printf("Execuções do script:     %d\n", BENCH_ITERATIONS);
+    printf("AST:  %8.3f s  (%7.1f ns/execução)  checksum %.6g\n",
+           ast_time.seconds, ast_time.seconds * 1e9 / BENCH_ITERATIONS, ast_time.checksum);
+    printf("VM:   %8.3f s  (%7.1f ns/execução)  checksum %.6g\n",
+           vm_time.seconds, vm_time.seconds * 1e9 / BENCH_ITERATIONS, vm_time.checksum);
+    if (vm_time.seconds > 0) {
+        printf("Ganho da VM:             %.2fx\n", ast_time.seconds / vm_time.seconds);
+    }
+
+    chunk_free(&chunk);
+    free_ast(ast);
+    arena_free(&arena);
+    evaluator_free(&state);
+    return 0;
+}
@@ -0,0 +1,439 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lang.h"
+#include "builtins.h"
+#include "functions.h"
+#include "output.h"
+#include "format.h"
+#include "a89alloc.h"
+
+//===================================================================
+// AUXILIARES DOS HANDLERS
+//===================================================================
+
+// Converte o resultado numérico em EvaluatorResult (NAN = erro matemático)
+static EvaluatorResult number_result(EvaluatorState* state, int id, double result) {
+    if (isnan(result)) {
+        char error_msg[STR_SIZE];
+        build_math_error_msg(error_msg, sizeof(error_msg), builtin_table[id].name);
+        return create_error_result(state, error_msg);
+    }
+    return create_success_result(create_number_value(result), 0);
+}
+
+static EvaluatorResult allocation_error(EvaluatorState* state) {
+    if (current_lang == LANG_PT)
+        return create_error_result(state, "Falha de alocação de memória");
+    else
+        return create_error_result(state, "Memory allocation failed");
+}
+
+//===================================================================
+// MATEMÁTICAS BÁSICAS - f(x)
+//===================================================================
+#define MATH1_HANDLER(handler, id, math_function)                               \
+    static EvaluatorResult handler(EvaluatorState* state, Value* args, int arg_count) { \
+        (void)arg_count;                                                        \
+        return number_result(state, id, math_function(VALUE_AS_DOUBLE(args[0]))); \
+    }
+
+MATH1_HANDLER(builtin_sqrt, BUILTIN_SQRT, math_sqrt)
+MATH1_HANDLER(builtin_sin,  BUILTIN_SIN,  math_sin)
+MATH1_HANDLER(builtin_cos,  BUILTIN_COS,  math_cos)
+MATH1_HANDLER(builtin_tan,  BUILTIN_TAN,  math_tan)
+MATH1_HANDLER(builtin_log,  BUILTIN_LOG,  math_log10)
+MATH1_HANDLER(builtin_ln,   BUILTIN_LN,   math_ln)
+MATH1_HANDLER(builtin_exp,  BUILTIN_EXP,  math_exp)
+MATH1_HANDLER(builtin_abs,  BUILTIN_ABS,  math_abs)
+
+//===================================================================
+// ESTATÍSTICAS - f(x1, x2, ...)
+//===================================================================
+#define STATS_HANDLER(handler, id, math_function)                               \
+    static EvaluatorResult handler(EvaluatorState* state, Value* args, int arg_count) { \
+        double* values = evaluator_numbers(state, args, arg_count);             \
+        if (values == NULL) return allocation_error(state);                     \
+        return number_result(state, id, math_function(values, arg_count));      \
+    }
+
+STATS_HANDLER(builtin_mean,     BUILTIN_MEAN,     math_mean)
+STATS_HANDLER(builtin_median,   BUILTIN_MEDIAN,   math_median)
+STATS_HANDLER(builtin_std,      BUILTIN_STD,      math_std)
+STATS_HANDLER(builtin_sum,      BUILTIN_SUM,      math_sum)
+STATS_HANDLER(builtin_min,      BUILTIN_MIN,      math_min)
+STATS_HANDLER(builtin_max,      BUILTIN_MAX,      math_max)
+STATS_HANDLER(builtin_variance, BUILTIN_VARIANCE, math_variance)
+STATS_HANDLER(builtin_mode,     BUILTIN_MODE,     math_mode)
+
+//===================================================================
+// FINANCEIRAS
+//===================================================================
+#define FIN3_HANDLER(handler, id, math_function)                                \
+    static EvaluatorResult handler(EvaluatorState* state, Value* args, int arg_count) { \
+        (void)arg_count;                                                        \
+        return number_result(state, id, math_function(VALUE_AS_DOUBLE(args[0]), \
+                                                      VALUE_AS_DOUBLE(args[1]), \
+                                                      VALUE_AS_DOUBLE(args[2]))); \
+    }
+
+FIN3_HANDLER(builtin_pv,    BUILTIN_PV,    math_pv)
+FIN3_HANDLER(builtin_fv,    BUILTIN_FV,    math_fv)
+FIN3_HANDLER(builtin_pmt,   BUILTIN_PMT,   math_pmt)
+FIN3_HANDLER(builtin_nper,  BUILTIN_NPER,  math_nper)
+FIN3_HANDLER(builtin_si,    BUILTIN_SI,    math_simple_interest)
+FIN3_HANDLER(builtin_fv_si, BUILTIN_FV_SI, math_simple_amount)
+FIN3_HANDLER(builtin_ci,    BUILTIN_CI,    math_compound_interest)
+FIN3_HANDLER(builtin_fv_ci, BUILTIN_FV_CI, math_compound_amount)
+
+static EvaluatorResult builtin_rate(EvaluatorState* state, Value* args, int arg_count) {
+    (void)arg_count;
+    return number_result(state, BUILTIN_RATE,
+                         math_rate(VALUE_AS_DOUBLE(args[0]), VALUE_AS_DOUBLE(args[1]),
+                                   VALUE_AS_DOUBLE(args[2]), VALUE_AS_DOUBLE(args[3])));
+}
+
+// npv(taxa, fluxo1, fluxo2, ...): o primeiro argumento é a taxa
+static EvaluatorResult builtin_npv(EvaluatorState* state, Value* args, int arg_count) {
+    double* cashflows = evaluator_numbers(state, args + 1, arg_count - 1);
+    if (cashflows == NULL) return allocation_error(state);
+    return number_result(state, BUILTIN_NPV,
+                         math_npv(VALUE_AS_DOUBLE(args[0]), cashflows, arg_count - 1));
+}
+
+// irr(fluxo1, fluxo2, ...): todos os argumentos são fluxos de caixa
+static EvaluatorResult builtin_irr(EvaluatorState* state, Value* args, int arg_count) {
+    double* cashflows = evaluator_numbers(state, args, arg_count);
+    if (cashflows == NULL) return allocation_error(state);
+    double guess = 0.1; // Chute inicial padrão
+    return number_result(state, BUILTIN_IRR, math_irr(cashflows, arg_count, guess));
+}
+
+//===================================================================
+// CONFIGURAÇÃO
+//===================================================================
+static EvaluatorResult builtin_setdec(EvaluatorState* state, Value* args, int arg_count) {
+    (void)arg_count;
+    int places = (int)VALUE_AS_DOUBLE(args[0]);
+    if (places < 0 || places > 15) {
+        if (current_lang == LANG_PT)
+            return create_error_result(state, "setdec: número de casas deve estar entre 0 e 15");
+        else
+            return create_error_result(state, "setdec: number of places must be between 0 and 15");
+    }
+
+    state->decimal_places = places;
+    return create_success_result(create_number_value(0.0), 1); // Sucesso silencioso
+}
+
+static EvaluatorResult builtin_clear(EvaluatorState* state, Value* args, int arg_count) {
+    (void)state; (void)args; (void)arg_count;
+    output_flush();     // O que já foi impresso sai antes de limpar
+    clear_screen();
+    return create_success_result(create_null_value(), 1); // Sucesso silencioso
+}
+
+//===================================================================
+// ENTRADA/SAÍDA
+//===================================================================
+static EvaluatorResult builtin_print(EvaluatorState* state, Value* args, int arg_count) {
+    for (int i = 0; i < arg_count; i++) {
+        print_value(args[i], state->decimal_places);
+        if (i < arg_count - 1) output_char(' ');
+    }
+    output_char('\n');
+
+    return create_success_result(create_null_value(), 1); // Sucesso silencioso
+}
+
+// printf(formato, ...): escreve direto na saída, sem criar strings (format.h)
+static EvaluatorResult builtin_printf(EvaluatorState* state, Value* args, int arg_count) {
+    char error_msg[256];
+
+    if (args[0].type != VAL_STRING) {
+        if (current_lang == LANG_PT)
+            return create_error_result(state, "printf: o primeiro argumento deve ser o formato (string)");
+        else
+            return create_error_result(state, "printf: the first argument must be the format (string)");
+    }
+    if (!format_print(args[0], args + 1, arg_count - 1, state->decimal_places,
+                      error_msg, sizeof(error_msg))) {
+        return create_error_result(state, error_msg);
+    }
+    return create_success_result(create_null_value(), 1); // Sucesso silencioso
+}
+
+static EvaluatorResult builtin_left(EvaluatorState* state, Value* args, int arg_count) {
+    (void)state;
+    return create_success_result(left(args, arg_count), 0);
+}
+
+static EvaluatorResult builtin_center(EvaluatorState* state, Value* args, int arg_count) {
+    (void)state;
+    return create_success_result(center(args, arg_count), 0);
+}
+
+static EvaluatorResult builtin_right(EvaluatorState* state, Value* args, int arg_count) {
+    (void)state;
+    return create_success_result(right(args, arg_count), 0);
+}
+
+//===================================================================
+// CORES E ESTILOS - f(texto)
+//===================================================================
+#define STYLE_HANDLER(handler, style_function)                                  \
+    static EvaluatorResult handler(EvaluatorState* state, Value* args, int arg_count) { \
+        (void)state; (void)arg_count;                                           \
+        return create_success_result(style_function(args[0]), 0);               \
+    }
+
+STYLE_HANDLER(builtin_black,          black)
+STYLE_HANDLER(builtin_red,            red)
+STYLE_HANDLER(builtin_green,          green)
+STYLE_HANDLER(builtin_yellow,         yellow)
+STYLE_HANDLER(builtin_blue,           blue)
+STYLE_HANDLER(builtin_magenta,        magenta)
+STYLE_HANDLER(builtin_cyan,           cyan)
+STYLE_HANDLER(builtin_white,          white)
+STYLE_HANDLER(builtin_bright_black,   bright_black)
+STYLE_HANDLER(builtin_bright_red,     bright_red)
+STYLE_HANDLER(builtin_bright_green,   bright_green)
+STYLE_HANDLER(builtin_bright_yellow,  bright_yellow)
+STYLE_HANDLER(builtin_bright_blue,    bright_blue)
+STYLE_HANDLER(builtin_bright_magenta, bright_magenta)
+STYLE_HANDLER(builtin_bright_cyan,    bright_cyan)
+STYLE_HANDLER(builtin_bright_white,   bright_white)
+
+STYLE_HANDLER(builtin_bg_black,          bg_black)
+STYLE_HANDLER(builtin_bg_red,            bg_red)
+STYLE_HANDLER(builtin_bg_green,          bg_green)
+STYLE_HANDLER(builtin_bg_yellow,         bg_yellow)
+STYLE_HANDLER(builtin_bg_blue,           bg_blue)
+STYLE_HANDLER(builtin_bg_magenta,        bg_magenta)
+STYLE_HANDLER(builtin_bg_cyan,           bg_cyan)
+STYLE_HANDLER(builtin_bg_white,          bg_white)
+STYLE_HANDLER(builtin_bg_bright_black,   bg_bright_black)
+STYLE_HANDLER(builtin_bg_bright_red,     bg_bright_red)
+STYLE_HANDLER(builtin_bg_bright_green,   bg_bright_green)
+STYLE_HANDLER(builtin_bg_bright_yellow,  bg_bright_yellow)
+STYLE_HANDLER(builtin_bg_bright_blue,    bg_bright_blue)
+STYLE_HANDLER(builtin_bg_bright_magenta, bg_bright_magenta)
+STYLE_HANDLER(builtin_bg_bright_cyan,    bg_bright_cyan)
+STYLE_HANDLER(builtin_bg_bright_white,   bg_bright_white)
+
+STYLE_HANDLER(builtin_bold,          bold)
+STYLE_HANDLER(builtin_dim,           dim)
+STYLE_HANDLER(builtin_italic,        italic)
+STYLE_HANDLER(builtin_underline,     underline)
+STYLE_HANDLER(builtin_blink,         blink)
+STYLE_HANDLER(builtin_inverse,       inverse)
+STYLE_HANDLER(builtin_hidden,        hidden)
+STYLE_HANDLER(builtin_strikethrough, strikethrough)
+
+//===================================================================
+// STRINGS
+//===================================================================
+static EvaluatorResult builtin_repeat(EvaluatorState* state, Value* args, int arg_count) {
+    (void)state; (void)arg_count;
+    return create_success_result(repeat(args[0], args[1]), 0);
+}
+
+//===================================================================
+// TABELA DE FUNÇÕES
+//===================================================================
+#define N ARGS_NUMBERS
+#define A ARGS_ANY
+#define V ARGS_VARIADIC
+#define P 1     // Pura: pode ser pré-calculada com argumentos constantes
+#define E 0     // Tem efeitos (saída, estado do avaliador)
+
+const BuiltinInfo builtin_table[BUILTIN_COUNT] = {
+    // nome, mín, máx, tipo dos argumentos, pura, handler
+    [BUILTIN_SQRT]     = { "sqrt",     1, 1, N, P, builtin_sqrt },
+    [BUILTIN_SIN]      = { "sin",      1, 1, N, P, builtin_sin },
+    [BUILTIN_COS]      = { "cos",      1, 1, N, P, builtin_cos },
+    [BUILTIN_TAN]      = { "tan",      1, 1, N, P, builtin_tan },
+    [BUILTIN_LOG]      = { "log",      1, 1, N, P, builtin_log },
+    [BUILTIN_LN]       = { "ln",       1, 1, N, P, builtin_ln },
+    [BUILTIN_EXP]      = { "exp",      1, 1, N, P, builtin_exp },
+    [BUILTIN_ABS]      = { "abs",      1, 1, N, P, builtin_abs },
+
+    [BUILTIN_MEAN]     = { "mean",     1, V, N, P, builtin_mean },
+    [BUILTIN_MEDIAN]   = { "median",   1, V, N, P, builtin_median },
+    [BUILTIN_STD]      = { "std",      1, V, N, P, builtin_std },
+    [BUILTIN_SUM]      = { "sum",      1, V, N, P, builtin_sum },
+    [BUILTIN_MIN]      = { "min",      1, V, N, P, builtin_min },
+    [BUILTIN_MAX]      = { "max",      1, V, N, P, builtin_max },
+    [BUILTIN_VARIANCE] = { "variance", 1, V, N, P, builtin_variance },
+    [BUILTIN_MODE]     = { "mode",     1, V, N, P, builtin_mode },
+
+    [BUILTIN_PV]       = { "pv",       3, 3, N, P, builtin_pv },
+    [BUILTIN_FV]       = { "fv",       3, 3, N, P, builtin_fv },
+    [BUILTIN_PMT]      = { "pmt",      3, 3, N, P, builtin_pmt },
+    [BUILTIN_NPER]     = { "nper",     3, 3, N, P, builtin_nper },
+    [BUILTIN_RATE]     = { "rate",     4, 4, N, P, builtin_rate },
+    [BUILTIN_SI]       = { "si",       3, 3, N, P, builtin_si },
+    [BUILTIN_FV_SI]    = { "fv_si",    3, 3, N, P, builtin_fv_si },
+    [BUILTIN_CI]       = { "ci",       3, 3, N, P, builtin_ci },
+    [BUILTIN_FV_CI]    = { "fv_ci",    3, 3, N, P, builtin_fv_ci },
+    [BUILTIN_NPV]      = { "npv",      2, V, N, P, builtin_npv },
+    [BUILTIN_IRR]      = { "irr",      2, V, N, P, builtin_irr },
+
+    [BUILTIN_SETDEC]   = { "setdec",   1, 1, N, E, builtin_setdec },
+    [BUILTIN_CLEAR]    = { "clear",    0, 0, A, E, builtin_clear },
+
+    [BUILTIN_PRINT]    = { "print",    0, V, A, E, builtin_print },
+    [BUILTIN_PRINTF]   = { "printf",   1, V, A, E, builtin_printf },
+    [BUILTIN_LEFT]     = { "left",     2, 2, A, P, builtin_left },
+    [BUILTIN_CENTER]   = { "center",   2, 2, A, P, builtin_center },
+    [BUILTIN_RIGHT]    = { "right",    2, 2, A, P, builtin_right },
+
+    [BUILTIN_BLACK]          = { "black",          1, 1, A, P, builtin_black },
+    [BUILTIN_RED]            = { "red",            1, 1, A, P, builtin_red },
+    [BUILTIN_GREEN]          = { "green",          1, 1, A, P, builtin_green },
+    [BUILTIN_YELLOW]         = { "yellow",         1, 1, A, P, builtin_yellow },
+    [BUILTIN_BLUE]           = { "blue",           1, 1, A, P, builtin_blue },
+    [BUILTIN_MAGENTA]        = { "magenta",        1, 1, A, P, builtin_magenta },
+    [BUILTIN_CYAN]           = { "cyan",           1, 1, A, P, builtin_cyan },
+    [BUILTIN_WHITE]          = { "white",          1, 1, A, P, builtin_white },
+    [BUILTIN_BRIGHT_BLACK]   = { "bright_black",   1, 1, A, P, builtin_bright_black },
+    [BUILTIN_BRIGHT_RED]     = { "bright_red",     1, 1, A, P, builtin_bright_red },
+    [BUILTIN_BRIGHT_GREEN]   = { "bright_green",   1, 1, A, P, builtin_bright_green },
+    [BUILTIN_BRIGHT_YELLOW]  = { "bright_yellow",  1, 1, A, P, builtin_bright_yellow },
+    [BUILTIN_BRIGHT_BLUE]    = { "bright_blue",    1, 1, A, P, builtin_bright_blue },
+    [BUILTIN_BRIGHT_MAGENTA] = { "bright_magenta", 1, 1, A, P, builtin_bright_magenta },
+    [BUILTIN_BRIGHT_CYAN]    = { "bright_cyan",    1, 1, A, P, builtin_bright_cyan },
+    [BUILTIN_BRIGHT_WHITE]   = { "bright_white",   1, 1, A, P, builtin_bright_white },
+
+    [BUILTIN_BG_BLACK]          = { "bg_black",          1, 1, A, P, builtin_bg_black },
+    [BUILTIN_BG_RED]            = { "bg_red",            1, 1, A, P, builtin_bg_red },
+    [BUILTIN_BG_GREEN]          = { "bg_green",          1, 1, A, P, builtin_bg_green },
+    [BUILTIN_BG_YELLOW]         = { "bg_yellow",         1, 1, A, P, builtin_bg_yellow },
+    [BUILTIN_BG_BLUE]           = { "bg_blue",           1, 1, A, P, builtin_bg_blue },
+    [BUILTIN_BG_MAGENTA]        = { "bg_magenta",        1, 1, A, P, builtin_bg_magenta },
+    [BUILTIN_BG_CYAN]           = { "bg_cyan",           1, 1, A, P, builtin_bg_cyan },
+    [BUILTIN_BG_WHITE]          = { "bg_white",          1, 1, A, P, builtin_bg_white },
+    [BUILTIN_BG_BRIGHT_BLACK]   = { "bg_bright_black",   1, 1, A, P, builtin_bg_bright_black },
+    [BUILTIN_BG_BRIGHT_RED]     = { "bg_bright_red",     1, 1, A, P, builtin_bg_bright_red },
+    [BUILTIN_BG_BRIGHT_GREEN]   = { "bg_bright_green",   1, 1, A, P, builtin_bg_bright_green },
+    [BUILTIN_BG_BRIGHT_YELLOW]  = { "bg_bright_yellow",  1, 1, A, P, builtin_bg_bright_yellow },
+    [BUILTIN_BG_BRIGHT_BLUE]    = { "bg_bright_blue",    1, 1, A, P, builtin_bg_bright_blue },
+    [BUILTIN_BG_BRIGHT_MAGENTA] = { "bg_bright_magenta", 1, 1, A, P, builtin_bg_bright_magenta },
+    [BUILTIN_BG_BRIGHT_CYAN]    = { "bg_bright_cyan",    1, 1, A, P, builtin_bg_bright_cyan },
+    [BUILTIN_BG_BRIGHT_WHITE]   = { "bg_bright_white",   1, 1, A, P, builtin_bg_bright_white },
+
+    [BUILTIN_BOLD]          = { "bold",          1, 1, A, P, builtin_bold },
+    [BUILTIN_DIM]           = { "dim",           1, 1, A, P, builtin_dim },
+    [BUILTIN_ITALIC]        = { "italic",        1, 1, A, P, builtin_italic },
+    [BUILTIN_UNDERLINE]     = { "underline",     1, 1, A, P, builtin_underline },
+    [BUILTIN_BLINK]         = { "blink",         1, 1, A, P, builtin_blink },
+    [BUILTIN_INVERSE]       = { "inverse",       1, 1, A, P, builtin_inverse },
+    [BUILTIN_HIDDEN]        = { "hidden",        1, 1, A, P, builtin_hidden },
+    [BUILTIN_STRIKETHROUGH] = { "strikethrough", 1, 1, A, P, builtin_strikethrough },
+
+    [BUILTIN_REPEAT]   = { "repeat",   2, 2, A, P, builtin_repeat },
+};
+
+#undef N
+#undef A
+#undef V
+#undef P
+#undef E
+
+//===================================================================
+// HASH PERFEITO
+//===================================================================
+/*
+ * FNV-1a com semente. A semente (BUILTIN_HASH_SEED, em builtins.h) foi
+ * escolhida por gen_builtin_hash.c de forma que os nomes de
+ * builtin_table caiam em posições distintas de builtin_slots (256
+ * posições). Cada posição
+ * guarda id + 1 (0 = vazia); o strcmp final rejeita identificadores que
+ * não são funções mas caem em uma posição ocupada.
+ */
+#define BUILTIN_SLOT_MASK 0xFF
+
+static const unsigned char builtin_slots[BUILTIN_SLOT_MASK + 1] = {
+    23, 72, 22,  0,  0,  0,  0,  0, 44,  0,  0,  0,  5,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 70, 66,  0, 30,  0,  9,
+     0, 57, 49,  0,  0,  0, 46, 29, 62,  0,  0,  0,  0,  0,  0,  0,
+     0,  4,  0,  0,  0, 17,  0,  0,  0,  0,  0,  0,  0, 47,  0,  0,
+     0, 63,  0,  0, 20,  0,  0,  0,  0, 61,  1, 67,  0,  0, 32,  0,
+     0,  0,  0,  0,  0,  7,  0,  0,  0,  0,  0,  0, 74,  0, 54,  0,
+     0, 35,  0,  0,  0,  0, 52,  0,  0,  0,  0, 43, 14,  0,  0,  0,
+    64,  0,  0,  0,  0,  0, 58,  0,  0,  0,  0, 59,  0,  0,  0, 12,
+    11,  0,  0, 28,  0,  0,  0,  0,  0,  0, 19,  0,  0, 60,  0,  0,
+     0,  0,  0, 53,  0,  0,  0,  0, 34, 13,  0,  0,  0, 51,  0,  0,
+    56,  0,  0,  0,  0, 40,  0,  0,  0, 18,  0,  0,  0,  0,  0,  0,
+    26, 31,  0,  0,  0,  0,  0,  0, 48,  0,  0, 15,  0,  0,  0,  0,
+    10,  0, 45, 25, 24,  0,  0, 39,  0, 73,  0, 65, 68,  6,  0,  0,
+     0,  0,  0,  0,  3,  0,  2, 21, 37,  0,  0,  0,  0,  0,  0,  0,
+    71,  0, 69, 55,  0,  0, 33,  0,  0,  0,  0, 27,  0,  0,  0, 41,
+     8,  0,  0,  0,  0, 42,  0,  0, 36, 38, 50,  0, 75,  0,  0, 16,
+};
+
+unsigned int builtin_hash(const char* name, int length, unsigned int seed) {
+    unsigned int hash = BUILTIN_HASH_INIT(seed);
+    for (int i = 0; i < length; i++) {
+        hash = BUILTIN_HASH_STEP(hash, name[i]);
+    }
+    return BUILTIN_HASH_FINISH(hash);
+}
+
+int builtin_lookup(const char* name, int length) {
+    return builtin_lookup_hashed(name, length, builtin_hash(name, length, BUILTIN_HASH_SEED));
+}
+
+int builtin_lookup_hashed(const char* name, int length, unsigned int hash) {
+    unsigned int slot = hash & BUILTIN_SLOT_MASK;
+    int id = (int)builtin_slots[slot] - 1;
+    if (id < 0) return BUILTIN_NONE;
+
+    const char* candidate = builtin_table[id].name;
+    if (strncmp(candidate, name, length) != 0 || candidate[length] != '\0') {
+        return BUILTIN_NONE;
+    }
+    return id;
+}
+
+//===================================================================
+// VALIDAÇÃO DE ARIDADE
+//===================================================================
+int builtin_check_arity(int id, int arg_count, char* buffer, int size) {
+    const BuiltinInfo* info = &builtin_table[id];
+    int too_few = arg_count < info->min_args;
+    int too_many = info->max_args != ARGS_VARIADIC && arg_count > info->max_args;
+
+    if (!too_few && !too_many) return 1;
+
+    if (info->max_args == 0) {
+        if (current_lang == LANG_PT)
+            snprintf(buffer, size, "Função %s não requer argumentos", info->name);
+        else
+            snprintf(buffer, size, "Function %s does not require arguments", info->name);
+    } else if (info->min_args == info->max_args) {
+        if (current_lang == LANG_PT)
+            snprintf(buffer, size, "Função %s requer exatamente %d argumento%s",
+                     info->name, info->min_args, info->min_args > 1 ? "s" : "");
+        else
+            snprintf(buffer, size, "Function %s requires exactly %d argument%s",
+                     info->name, info->min_args, info->min_args > 1 ? "s" : "");
+    } else if (too_few) {
+        if (current_lang == LANG_PT)
+            snprintf(buffer, size, "Função %s requer pelo menos %d argumento%s",
+                     info->name, info->min_args, info->min_args > 1 ? "s" : "");
+        else
+            snprintf(buffer, size, "Function %s requires at least %d argument%s",
+                     info->name, info->min_args, info->min_args > 1 ? "s" : "");
+    } else {
+        if (current_lang == LANG_PT)
+            snprintf(buffer, size, "Função %s aceita no máximo %d argumento%s",
+                     info->name, info->max_args, info->max_args > 1 ? "s" : "");
+        else
+            snprintf(buffer, size, "Function %s accepts at most %d argument%s",
+                     info->name, info->max_args, info->max_args > 1 ? "s" : "");
+    }
+    return 0;
+}
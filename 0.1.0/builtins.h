@@ -0,0 +1,111 @@
+#ifndef BUILTINS_H
+#define BUILTINS_H
+
+#include "common.h"
+#include "value.h"
+#include "evaluator.h"
+
+/*
+ * FUNÇÕES BUILT-IN - RUDIS
+ *
+ * Tabela única com todas as funções da linguagem. O lexer reconhece o
+ * nome por hash perfeito (builtin_lookup) e guarda o ID no token; o
+ * parser valida a aridade pela tabela e guarda o ID no nó da AST; o
+ * avaliador chama o handler diretamente pelo ID.
+ *
+ * A ordem de BuiltinId deve ser a mesma de builtin_table (builtins.c).
+ * Ao adicionar uma função, gere de novo a tabela de hash com
+ * gen_builtin_hash.c.
+ */
+typedef enum {
+    BUILTIN_NONE = -1,
+
+    // ============ MATEMÁTICAS BÁSICAS ============
+    BUILTIN_SQRT, BUILTIN_SIN, BUILTIN_COS, BUILTIN_TAN,
+    BUILTIN_LOG, BUILTIN_LN, BUILTIN_EXP, BUILTIN_ABS,
+
+    // ============ ESTATÍSTICAS ============
+    BUILTIN_MEAN, BUILTIN_MEDIAN, BUILTIN_STD, BUILTIN_SUM,
+    BUILTIN_MIN, BUILTIN_MAX, BUILTIN_VARIANCE, BUILTIN_MODE,
+
+    // ============ FINANCEIRAS ============
+    BUILTIN_PV, BUILTIN_FV, BUILTIN_PMT, BUILTIN_NPER, BUILTIN_RATE,
+    BUILTIN_SI, BUILTIN_FV_SI, BUILTIN_CI, BUILTIN_FV_CI,
+    BUILTIN_NPV, BUILTIN_IRR,
+
+    // ============ CONFIGURAÇÃO ============
+    BUILTIN_SETDEC, BUILTIN_CLEAR,
+
+    // ============ ENTRADA/SAÍDA ============
+    BUILTIN_PRINT, BUILTIN_PRINTF, BUILTIN_LEFT, BUILTIN_CENTER, BUILTIN_RIGHT,
+
+    // ============ CORES DO TEXTO ============
+    BUILTIN_BLACK, BUILTIN_RED, BUILTIN_GREEN, BUILTIN_YELLOW,
+    BUILTIN_BLUE, BUILTIN_MAGENTA, BUILTIN_CYAN, BUILTIN_WHITE,
+    BUILTIN_BRIGHT_BLACK, BUILTIN_BRIGHT_RED, BUILTIN_BRIGHT_GREEN,
+    BUILTIN_BRIGHT_YELLOW, BUILTIN_BRIGHT_BLUE, BUILTIN_BRIGHT_MAGENTA,
+    BUILTIN_BRIGHT_CYAN, BUILTIN_BRIGHT_WHITE,
+
+    // ============ CORES DE FUNDO ============
+    BUILTIN_BG_BLACK, BUILTIN_BG_RED, BUILTIN_BG_GREEN, BUILTIN_BG_YELLOW,
+    BUILTIN_BG_BLUE, BUILTIN_BG_MAGENTA, BUILTIN_BG_CYAN, BUILTIN_BG_WHITE,
+    BUILTIN_BG_BRIGHT_BLACK, BUILTIN_BG_BRIGHT_RED, BUILTIN_BG_BRIGHT_GREEN,
+    BUILTIN_BG_BRIGHT_YELLOW, BUILTIN_BG_BRIGHT_BLUE, BUILTIN_BG_BRIGHT_MAGENTA,
+    BUILTIN_BG_BRIGHT_CYAN, BUILTIN_BG_BRIGHT_WHITE,
+
+    // ============ ESTILOS ============
+    BUILTIN_BOLD, BUILTIN_DIM, BUILTIN_ITALIC, BUILTIN_UNDERLINE,
+    BUILTIN_BLINK, BUILTIN_INVERSE, BUILTIN_HIDDEN, BUILTIN_STRIKETHROUGH,
+
+    // ============ STRINGS ============
+    BUILTIN_REPEAT,
+
+    BUILTIN_COUNT
+} BuiltinId;
+
+// Tipos de argumento aceitos por uma função
+typedef enum {
+    ARGS_ANY,       // Qualquer tipo (a própria função valida)
+    ARGS_NUMBERS    // Todos os argumentos devem ser números
+} ArgKind;
+
+#define ARGS_VARIADIC -1    // max_args sem limite
+
+// Handler de uma função: recebe os argumentos já avaliados (emprestados)
+typedef EvaluatorResult (*BuiltinHandler)(EvaluatorState* state, Value* args, int arg_count);
+
+typedef struct {
+    const char* name;
+    int min_args;
+    int max_args;           // ARGS_VARIADIC = sem limite
+    ArgKind arg_kind;
+    int pure;               // Sem efeitos e sem depender do estado (otimizador)
+    BuiltinHandler handler;
+} BuiltinInfo;
+
+extern const BuiltinInfo builtin_table[BUILTIN_COUNT];
+
+/*
+ * Hash da tabela perfeita: FNV-1a com semente, um byte por vez. Os
+ * macros permitem calcular o hash enquanto o nome é lido (o lexer faz
+ * isso) e depois chamar builtin_lookup_hashed() sem percorrer o nome
+ * de novo. A semente é gerada por gen_builtin_hash.c.
+ */
+#define BUILTIN_HASH_SEED 15424u
+#define BUILTIN_HASH_INIT(seed) (2166136261u ^ (seed))
+#define BUILTIN_HASH_STEP(hash, c) (((hash) ^ (unsigned char)(c)) * 16777619u)
+#define BUILTIN_HASH_FINISH(hash) ((hash) ^ ((hash) >> 15))
+
+// Hash usado pela tabela perfeita (exposto para gen_builtin_hash.c)
+unsigned int builtin_hash(const char* name, int length, unsigned int seed);
+
+// Retorna o BuiltinId do nome (length bytes) ou BUILTIN_NONE
+int builtin_lookup(const char* name, int length);
+
+// Igual a builtin_lookup(), com o hash (BUILTIN_HASH_FINISH) já calculado
+int builtin_lookup_hashed(const char* name, int length, unsigned int hash);
+
+// Verifica a aridade; em caso de erro escreve a mensagem em buffer
+int builtin_check_arity(int id, int arg_count, char* buffer, int size);
+
+#endif // BUILTINS_H
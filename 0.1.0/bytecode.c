@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "bytecode.h"
+#include "builtins.h"
+#include "output.h"
+#include "a89alloc.h"
+
+#define INITIAL_CODE_CAPACITY 64
+#define INITIAL_CONSTANT_CAPACITY 16
+
+void chunk_init(Chunk* chunk) {
+    chunk->code = NULL;
+    chunk->positions = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->constants = NULL;
+    chunk->constant_count = 0;
+    chunk->constant_capacity = 0;
+    chunk->max_stack = 0;
+}
+
+void chunk_reset(Chunk* chunk) {
+    for (int i = 0; i < chunk->constant_count; i++) {
+        value_release(&chunk->constants[i]);
+    }
+    chunk->count = 0;
+    chunk->constant_count = 0;
+    chunk->max_stack = 0;
+}
+
+void chunk_free(Chunk* chunk) {
+    chunk_reset(chunk);
+    a89free(chunk->code);
+    a89free(chunk->positions);
+    a89free(chunk->constants);
+    chunk_init(chunk);
+}
+
+//===================================================================
+// EMISSÃO DE INSTRUÇÕES
+//===================================================================
+
+// Estado da compilação de uma AST
+typedef struct {
+    Chunk* chunk;
+    int depth;      // Profundidade atual da pilha
+    int ok;         // 0 depois da primeira falha
+} Compiler;
+
+static void emit_word(Compiler* compiler, unsigned int word, int position) {
+    Chunk* chunk = compiler->chunk;
+    if (!compiler->ok) return;
+
+    if (chunk->count >= chunk->capacity) {
+        int new_capacity = chunk->capacity ? chunk->capacity * 2 : INITIAL_CODE_CAPACITY;
+        unsigned int* new_code = (unsigned int*)A89ALLOC(new_capacity * sizeof(unsigned int));
+        int* new_positions = (int*)A89ALLOC(new_capacity * sizeof(int));
+        if (!new_code || !new_positions) {
+            a89free(new_code);
+            a89free(new_positions);
+            compiler->ok = 0;
+            return;
+        }
+        if (chunk->code != NULL) {
+            memcpy(new_code, chunk->code, chunk->count * sizeof(unsigned int));
+            memcpy(new_positions, chunk->positions, chunk->count * sizeof(int));
+            a89free(chunk->code);
+            a89free(chunk->positions);
+        }
+        chunk->code = new_code;
+        chunk->positions = new_positions;
+        chunk->capacity = new_capacity;
+    }
+
+    chunk->code[chunk->count] = word;
+    chunk->positions[chunk->count] = position;
+    chunk->count++;
+}
+
+// Emite uma instrução e atualiza a profundidade da pilha (effect =
+// valores empilhados menos desempilhados)
+static void emit(Compiler* compiler, OpCode op, unsigned int operand, int effect, int position) {
+    if (operand > OP_OPERAND_MAX) {
+        compiler->ok = 0;
+        return;
+    }
+    emit_word(compiler, OP_ENCODE(op, operand), position);
+
+    compiler->depth += effect;
+    if (compiler->depth > compiler->chunk->max_stack) {
+        compiler->chunk->max_stack = compiler->depth;
+    }
+}
+
+static int add_constant(Compiler* compiler, Value value) {
+    Chunk* chunk = compiler->chunk;
+
+    if (chunk->constant_count >= chunk->constant_capacity) {
+        int new_capacity = chunk->constant_capacity ? chunk->constant_capacity * 2
+                                                    : INITIAL_CONSTANT_CAPACITY;
+        Value* new_constants = (Value*)A89ALLOC(new_capacity * sizeof(Value));
+        if (!new_constants) {
+            compiler->ok = 0;
+            return 0;
+        }
+        if (chunk->constants != NULL) {
+            memcpy(new_constants, chunk->constants, chunk->constant_count * sizeof(Value));
+            a89free(chunk->constants);
+        }
+        chunk->constants = new_constants;
+        chunk->constant_capacity = new_capacity;
+    }
+
+    chunk->constants[chunk->constant_count] = value_retain(value);
+    return chunk->constant_count++;
+}
+
+static OpCode binary_opcode(char operator) {
+    switch (operator) {
+        case '+': return OP_ADD;
+        case '-': return OP_SUBTRACT;
+        case '*': return OP_MULTIPLY;
+        case '/': return OP_DIVIDE;
+        case '%': return OP_MODULO;
+        case '^': return OP_POWER;
+        case '&': return OP_BIT_AND;
+        case '|': return OP_BIT_OR;
+        case '~': return OP_BIT_XOR;
+        case '<': return OP_SHIFT_LEFT;
+        case '>': return OP_SHIFT_RIGHT;
+        default:  return OP_COUNT;
+    }
+}
+
+//===================================================================
+// COMPILAÇÃO DA AST
+//===================================================================
+// Emite o código de um nó cujos filhos já foram compilados
+static void compile_node_exit(Compiler* compiler, ASTNode* node) {
+    switch (node->type) {
+        case NODE_NUMBER:
+        case NODE_STRING:
+            {
+                int index = add_constant(compiler, node->as.value);
+                emit(compiler, OP_CONSTANT, (unsigned int)index, 1, node->position);
+            }
+            break;
+
+        case NODE_VARIABLE:
+            if (node->as.variable.slot < 0) {
+                compiler->ok = 0;
+                return;
+            }
+            emit(compiler, OP_LOAD, (unsigned int)node->as.variable.slot, 1, node->position);
+            break;
+
+        case NODE_ASSIGNMENT:
+            if (node->as.variable.slot < 0) {
+                compiler->ok = 0;
+                return;
+            }
+            emit(compiler, OP_STORE, (unsigned int)node->as.variable.slot, 0, node->position);
+            break;
+
+        case NODE_BINARY_OP:
+            {
+                OpCode op = binary_opcode(node->operator);
+                if (op == OP_COUNT) {
+                    compiler->ok = 0;
+                    return;
+                }
+                emit(compiler, op, 0, -1, node->position);
+            }
+            break;
+
+        case NODE_CONCAT:
+            emit(compiler, OP_CONCAT, (unsigned int)node->as.concat.count,
+                 1 - node->as.concat.count, node->position);
+            break;
+
+        case NODE_UNARY_OP:
+            if (node->operator == '-') {
+                emit(compiler, OP_NEGATE, 0, 0, node->position);
+            } else if (node->operator == '!') {
+                emit(compiler, OP_FACTORIAL, 0, 0, node->position);
+            } else if (node->operator == '~') {
+                emit(compiler, OP_BIT_NOT, 0, 0, node->position);
+            } else {
+                compiler->ok = 0;
+            }
+            break;
+
+        case NODE_FUNCTION:
+            if (node->as.call.builtin_id < 0 || node->as.call.builtin_id >= BUILTIN_COUNT) {
+                compiler->ok = 0;
+                return;
+            }
+            // Os argumentos viram um único resultado
+            emit(compiler, OP_CALL, (unsigned int)node->as.call.builtin_id,
+                 1 - node->as.call.arg_count, node->position);
+            emit_word(compiler, (unsigned int)node->as.call.arg_count, node->position);
+            break;
+
+        default:
+            compiler->ok = 0;
+            break;
+    }
+}
+
+// Pós-ordem sem recursão: os filhos empilham os seus valores antes do
+// pai, da esquerda para a direita
+static void compile_node(Compiler* compiler, ASTNode* node) {
+    ASTWalk walk;
+    int leaving;
+
+    if (node == NULL) {
+        compiler->ok = 0;
+        return;
+    }
+
+    ast_walk_begin(&walk, node);
+    while (compiler->ok && (node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (leaving) compile_node_exit(compiler, node);
+    }
+    if (walk.error != AST_WALK_OK) compiler->ok = 0;
+    ast_walk_end(&walk);
+}
+
+static ResultKind result_kind(ASTNode* node) {
+    if (node->type == NODE_ASSIGNMENT) return RESULT_ASSIGNMENT;
+    if (node->type == NODE_FUNCTION) return RESULT_CALL;
+    return RESULT_VALUE;
+}
+
+int compile_ast(Chunk* chunk, ASTNode* ast) {
+    Compiler compiler;
+    compiler.chunk = chunk;
+    compiler.depth = 0;
+    compiler.ok = 1;
+
+    chunk_reset(chunk);
+    if (ast == NULL) return 0;
+
+    if (ast->type == NODE_SEQUENCE) {
+        for (int i = 0; i < ast->as.sequence.count; i++) {
+            ASTNode* statement = ast->as.sequence.statements[i];
+            if (statement == NULL || statement->type == NODE_SEQUENCE) {
+                compiler.ok = 0;
+                break;
+            }
+            compile_node(&compiler, statement);
+            emit(&compiler, OP_STATEMENT, result_kind(statement), -1, statement->position);
+        }
+        emit(&compiler, OP_RETURN, RESULT_SEQUENCE, 0, ast->position);
+    } else {
+        compile_node(&compiler, ast);
+        emit(&compiler, OP_RETURN, result_kind(ast), 0, ast->position);
+    }
+
+    if (!compiler.ok) {
+        chunk_reset(chunk);
+        return 0;
+    }
+    return 1;
+}
+
+//===================================================================
+// DEBUG
+//===================================================================
+static const char* opcode_names[OP_COUNT] = {
+    [OP_CONSTANT]  = "CONSTANT",
+    [OP_LOAD]      = "LOAD",
+    [OP_STORE]     = "STORE",
+    [OP_ADD]       = "ADD",
+    [OP_CONCAT]    = "CONCAT",
+    [OP_SUBTRACT]  = "SUBTRACT",
+    [OP_MULTIPLY]  = "MULTIPLY",
+    [OP_DIVIDE]    = "DIVIDE",
+    [OP_MODULO]    = "MODULO",
+    [OP_POWER]     = "POWER",
+    [OP_BIT_AND]   = "BIT_AND",
+    [OP_BIT_OR]    = "BIT_OR",
+    [OP_BIT_XOR]   = "BIT_XOR",
+    [OP_SHIFT_LEFT]  = "SHIFT_LEFT",
+    [OP_SHIFT_RIGHT] = "SHIFT_RIGHT",
+    [OP_NEGATE]    = "NEGATE",
+    [OP_FACTORIAL] = "FACTORIAL",
+    [OP_BIT_NOT]   = "BIT_NOT",
+    [OP_CALL]      = "CALL",
+    [OP_STATEMENT] = "STATEMENT",
+    [OP_RETURN]    = "RETURN",
+};
+
+static const char* result_names[] = {
+    "VALUE", "ASSIGNMENT", "CALL", "SEQUENCE"
+};
+
+void chunk_disassemble(const Chunk* chunk) {
+    output_printf("=== BYTECODE (%d palavras, pilha máx. %d) ===\n",
+                  chunk->count, chunk->max_stack);
+
+    for (int i = 0; i < chunk->count; i++) {
+        unsigned int instruction = chunk->code[i];
+        unsigned int op = OP_CODE(instruction);
+        unsigned int operand = OP_OPERAND(instruction);
+
+        output_printf("%04d  %-10s", i, op < OP_COUNT ? opcode_names[op] : "???");
+        switch (op) {
+            case OP_CONSTANT:
+                output_printf(" %u  (", operand);
+                print_value(chunk->constants[operand], 6);
+                output_char(')');
+                break;
+            case OP_LOAD:
+            case OP_STORE:
+                output_printf(" slot %u", operand);
+                break;
+            case OP_CONCAT:
+                output_printf(" %u", operand);
+                break;
+            case OP_CALL:
+                output_printf(" %s/%u", builtin_table[operand].name, chunk->code[i + 1]);
+                i++;
+                break;
+            case OP_STATEMENT:
+            case OP_RETURN:
+                output_printf(" %s", operand < RESULT_SEQUENCE + 1 ? result_names[operand] : "?");
+                break;
+            default:
+                break;
+        }
+        output_char('\n');
+    }
+}
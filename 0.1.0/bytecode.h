@@ -0,0 +1,109 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include "common.h"
+#include "value.h"
+#include "parser.h"
+
+/********************************************************************
+BYTECODE - RUDIS
+
+A AST de uma entrada é traduzida para uma sequência linear de
+instruções de uma máquina de pilha (ver vm.h). Cada instrução ocupa
+uma palavra de 32 bits: 8 bits de opcode e 24 bits de operando.
+OP_CALL usa uma segunda palavra com o número de argumentos.
+
+Exemplo: x = 2 * (y + 1)
+    CONSTANT  2
+    LOAD      y
+    CONSTANT  1
+    ADD
+    MULTIPLY
+    STORE     x
+    RETURN    ASSIGNMENT
+
+Os operandos são empilhados na mesma ordem em que evaluate() avalia
+a AST, então efeitos (print) e erros acontecem na mesma sequência.
+********************************************************************/
+
+typedef enum {
+    OP_CONSTANT,    // Empilha constants[operando]
+    OP_LOAD,        // Empilha o valor do slot [operando]
+    OP_STORE,       // Copia o topo para o slot [operando] (o valor fica na pilha)
+    OP_ADD,         // + (números) ou concatenação
+    OP_CONCAT,      // Cadeia a + b + ... com texto (operando = número de valores)
+    OP_SUBTRACT,
+    OP_MULTIPLY,
+    OP_DIVIDE,
+    OP_MODULO,
+    OP_POWER,
+    OP_BIT_AND,     // &
+    OP_BIT_OR,      // |
+    OP_BIT_XOR,     // ~ binário
+    OP_SHIFT_LEFT,  // <<
+    OP_SHIFT_RIGHT, // >>
+    OP_NEGATE,      // - unário
+    OP_FACTORIAL,   // ! pós-fixo
+    OP_BIT_NOT,     // ~ unário
+    OP_CALL,        // operando = builtin_id; a próxima palavra é o número de argumentos
+    OP_STATEMENT,   // Fim de um statement de uma sequência (operando = ResultKind)
+    OP_RETURN,      // Termina (operando = ResultKind)
+    OP_COUNT
+} OpCode;
+
+// Se o resultado de um statement é impresso, como em evaluate(): uma
+// atribuição nunca é; uma chamada depende da função (setdec, clear e
+// print retornam is_assignment = 1); numa sequência vale o último
+// statement com resultado impresso.
+typedef enum {
+    RESULT_VALUE,       // Expressão: o topo é o resultado
+    RESULT_ASSIGNMENT,  // Atribuição: o topo é o resultado, não impresso
+    RESULT_CALL,        // Chamada: o topo é o resultado, a função decide
+    RESULT_SEQUENCE     // (só OP_RETURN) resultado guardado por OP_STATEMENT
+} ResultKind;
+
+#define OP_OPERAND_BITS 24
+#define OP_OPERAND_MAX ((1u << OP_OPERAND_BITS) - 1)
+
+#define OP_ENCODE(op, operand) ((unsigned int)(op) | ((unsigned int)(operand) << 8))
+#define OP_CODE(instruction) ((instruction) & 0xFFu)
+#define OP_OPERAND(instruction) ((instruction) >> 8)
+
+/*
+ * CHUNK - código compilado de uma entrada
+ *
+ * - code / positions: instruções e, para cada uma, a posição no
+ *   código-fonte do nó que a gerou (usada nas mensagens de erro)
+ * - constants: números e strings literais (cada string tem uma
+ *   referência própria, solta em chunk_reset)
+ * - max_stack: profundidade máxima da pilha, reservada antes de executar
+ *
+ * O chunk é reaproveitado: chunk_reset() mantém os vetores alocados.
+ */
+typedef struct {
+    unsigned int* code;
+    int* positions;
+    int count;
+    int capacity;
+    Value* constants;
+    int constant_count;
+    int constant_capacity;
+    int max_stack;
+} Chunk;
+
+void chunk_init(Chunk* chunk);
+
+// Solta as constantes e esvazia o chunk (mantém a memória)
+void chunk_reset(Chunk* chunk);
+
+void chunk_free(Chunk* chunk);
+
+// Compila a AST (já resolvida com resolve_variables) para o chunk.
+// Retorna 0 se não for possível (falha de alocação, slot não
+// resolvido ou limites do formato); nesse caso use evaluate().
+int compile_ast(Chunk* chunk, ASTNode* ast);
+
+// Imprime as instruções (para debug)
+void chunk_disassemble(const Chunk* chunk);
+
+#endif // BYTECODE_H
@@ -54,4 +54,4 @@
 #define SUCCESS_COLOR GREEN BOLD
 #define INFO_COLOR    CYAN
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
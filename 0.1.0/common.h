@@ -16,4 +16,4 @@
 
 #define VERSION "0.1.0"
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
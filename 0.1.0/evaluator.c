@@ -2,1080 +2,638 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
 
 #include "lang.h"
 #include "evaluator.h"
+#include "builtins.h"
 #include "functions.h"
+#include "number.h"
+#include "output.h"
 #include "a89alloc.h"
 
+#define INITIAL_VARIABLE_CAPACITY 16
+#define NAME_CHUNK_SIZE 4096
+#define INITIAL_STACK_CAPACITY 32
+
 void evaluator_init(EvaluatorState* state) {
     state->variables = NULL;
     state->variable_count = 0;
+    state->variable_capacity = 0;
+    state->buckets = NULL;
+    state->bucket_count = 0;
+    state->names = NULL;
+    state->slots = NULL;
+    state->stack = NULL;
+    state->stack_top = 0;
+    state->stack_capacity = 0;
+    state->numbers = NULL;
+    state->numbers_capacity = 0;
     state->decimal_places = 6;
 }
 
 void evaluator_free(EvaluatorState* state) {
-    Variable* current = state->variables;
-    while (current != NULL) {
-        Variable* next = current->next;
-        a89free(current);
-        current = next;
-    }
+    NameChunk* chunk = state->names;
+    while (chunk != NULL) {
+        NameChunk* next = chunk->next;
+        a89free(chunk);
+        chunk = next;
+    }
+    for (int i = 0; i < state->variable_count; i++) {
+        value_release(&state->slots[i]);
+    }
+    a89free(state->variables);
+    a89free(state->slots);
+    a89free(state->buckets);
+    for (int i = 0; i < state->stack_top; i++) {
+        value_release(&state->stack[i]);
+    }
+    a89free(state->stack);
+    a89free(state->numbers);
+    state->stack = NULL;
+    state->stack_top = 0;
+    state->stack_capacity = 0;
+    state->numbers = NULL;
+    state->numbers_capacity = 0;
     state->variables = NULL;
     state->variable_count = 0;
+    state->variable_capacity = 0;
+    state->buckets = NULL;
+    state->bucket_count = 0;
+    state->names = NULL;
+    state->slots = NULL;
 }
 
-Value get_variable(EvaluatorState* state, const char* variable_name) {
-    Variable* current = state->variables;
-    while (current != NULL) {
-        if (strcmp(current->name, variable_name) == 0) {
-            return current->value;
-        }
-        current = current->next;
-    }
-    return create_null_value(); // Retorna null
+//===================================================================
+// PILHA DE ARGUMENTOS
+//===================================================================
+
+int evaluator_reserve_stack(EvaluatorState* state, int count) {
+    if (state->stack_capacity - state->stack_top >= count) return 1;
+
+    int new_capacity = state->stack_capacity ? state->stack_capacity * 2
+                                             : INITIAL_STACK_CAPACITY;
+    while (new_capacity - state->stack_top < count) new_capacity *= 2;
+    Value* new_stack = (Value*)A89ALLOC(new_capacity * sizeof(Value));
+    if (!new_stack) return 0;
+    if (state->stack != NULL) {
+        memcpy(new_stack, state->stack, state->stack_top * sizeof(Value));
+        a89free(state->stack);
+    }
+    state->stack = new_stack;
+    state->stack_capacity = new_capacity;
+    return 1;
 }
 
-void set_variable(EvaluatorState* state, const char* variable_name, Value value) {
-    Variable* current = state->variables;
-    while (current != NULL) {
-        if (strcmp(current->name, variable_name) == 0) {
-            current->value = value;
-            current->initialized = 1;
-            return;
-        }
-        current = current->next;
-    }
-    
-    // Cria nova variável
-    Variable* new_var = (Variable*)A89ALLOC(sizeof(Variable));
-    strncpy(new_var->name, variable_name, sizeof(new_var->name) - 1);
-    new_var->name[sizeof(new_var->name) - 1] = '\0';
-    new_var->value = value;
-    new_var->initialized = 1;
-    new_var->next = state->variables;
-    state->variables = new_var;
-    state->variable_count++;
+// Garante espaço para mais um valor na pilha
+static int reserve_stack(EvaluatorState* state) {
+    return evaluator_reserve_stack(state, 1);
 }
 
-int variable_exists(EvaluatorState* state, const char* variable_name) {
-    Variable* current = state->variables;
-    while (current != NULL) {
-        if (strcmp(current->name, variable_name) == 0) {
-            return 1;
-        }
-        current = current->next;
+// Desempilha (e solta) os valores acima de base
+static void pop_stack(EvaluatorState* state, int base) {
+    while (state->stack_top > base) {
+        value_release(&state->stack[--state->stack_top]);
     }
-    return 0;
 }
 
-void print_variables(EvaluatorState* state) {
-    printf("=== Variáveis no estado ===\n");
-    
-    Variable* current = state->variables;
-    int count = 0;
-    
-    while (current != NULL) {
-        printf("%d. %s: ", ++count, current->name);
-        print_value(current->value, state->decimal_places); 
-        printf("\n");
-        current = current->next;
+double* evaluator_numbers(EvaluatorState* state, Value* args, int count) {
+    if (count > state->numbers_capacity) {
+        int new_capacity = state->numbers_capacity ? state->numbers_capacity : INITIAL_STACK_CAPACITY;
+        while (new_capacity < count) new_capacity *= 2;
+        double* new_numbers = (double*)A89ALLOC(new_capacity * sizeof(double));
+        if (!new_numbers) return NULL;
+        a89free(state->numbers);
+        state->numbers = new_numbers;
+        state->numbers_capacity = new_capacity;
     }
-    
-    if (count == 0) {
-        printf("Nenhuma variável definida\n");
+    for (int i = 0; i < count; i++) {
+        state->numbers[i] = VALUE_AS_DOUBLE(args[i]);
     }
-    printf("===========================\n");
-}
-
-EvaluatorResult create_success_result(Value value, int is_assignment) {
-    EvaluatorResult result;
-    result.success = 1;
-    result.value = value;
-    result.error_message[0] = '\0';
-    result.is_assignment = is_assignment;
-    return result;
-}
-
-EvaluatorResult create_error_result(const char* message) {
-    EvaluatorResult result;
-    result.success = 0;
-    result.value = create_null_value();
-    strncpy(result.error_message, message, sizeof(result.error_message) - 1);
-    result.error_message[sizeof(result.error_message) - 1] = '\0';
-    result.is_assignment = 0;
-    return result;
+    return state->numbers;
 }
 
 //===================================================================
-// AVALIA A AST
+// TABELA HASH DE VARIÁVEIS
 //===================================================================
-EvaluatorResult evaluate(EvaluatorState* state, ASTNode* node) {
-    if (node == NULL) {
-        if(current_lang == LANG_PT)
-            return create_error_result("Nó AST nulo");
-        else 
-            return create_error_result("Null AST node");
-    }
-    
-    switch (node->type) {
-        case NODE_NUMBER:
-            return create_success_result(node->value, 0);
-            
-        case NODE_STRING:
-            return create_success_result(node->value, 0);
-            
-        case NODE_VARIABLE:  
-            if (variable_exists(state, node->text)) {  
-                return create_success_result(get_variable(state, node->text), 0);  
-            } else {
-                if (current_lang == LANG_PT)
-                    return create_error_result("Variável não definida");
-                else 
-                    return create_error_result("Variable not defined");
-            }
-            
-        case NODE_ASSIGNMENT:
-            {
-                EvaluatorResult right_result = evaluate(state, node->right);
-                if (!right_result.success) {
-                    return right_result;
-                }
-                set_variable(state, node->text, right_result.value);  
-                return create_success_result(right_result.value, 1);
-            }
-            
-        case NODE_BINARY_OP:
-            {
-                EvaluatorResult left_result = evaluate(state, node->left);
-                if (!left_result.success) {
-                    return left_result;
-                }
-                
-                EvaluatorResult right_result = evaluate(state, node->right);
-                if (!right_result.success) {
-                    return right_result;
-                }
-                
-                if (left_result.value.type == VAL_NUMBER && right_result.value.type == VAL_NUMBER) {  
-                    double result;
-                    switch (node->operator) {
-                        case '+': result = left_result.value.number + right_result.value.number; break;
-                        case '-': result = left_result.value.number - right_result.value.number; break;
-                        case '*': result = left_result.value.number * right_result.value.number; break;
-                        case '/': 
-                            if (right_result.value.number == 0) {
-                                if (current_lang == LANG_PT)
-                                    return create_error_result("Divisão por zero");
-                                else 
-                                    return create_error_result("Division by zero");
-                            }
-                            result = left_result.value.number / right_result.value.number; 
-                            break;
-                        case '%': 
-                            if ((int)right_result.value.number == 0) {
-                                if (current_lang == LANG_PT)
-                                    return create_error_result("Módulo por zero");
-                                else 
-                                    return create_error_result("Modulo by zero");
-                            }
-                            result = (int)left_result.value.number % (int)right_result.value.number; 
-                            break;
-                        case '^': result = power(left_result.value.number, right_result.value.number); break;
-                        default: 
-                            if (current_lang == LANG_PT)
-                                return create_error_result("Operador binário inválido");
-                            else 
-                                return create_error_result("Invalid binary operator");
-                    }
-                    return create_success_result(create_number_value(result), 0);
-                } else {
-                    if(node->operator == '+'){
-                        return string_concatenate(&left_result, &right_result, -1);
-                    } else {
-                        // Outros operadores com strings → ERRO
-                        if (current_lang == LANG_PT)
-                            return create_error_result("Operações aritméticas requerem números");
-                        else 
-                            return create_error_result("Arithmetic operations require numbers");
-                    }
-                
-                }
-            }
-            
-        case NODE_UNARY_OP:
-            {
-                EvaluatorResult operand_result = evaluate(state, node->operand);  
-                if (!operand_result.success) {
-                    return operand_result;
-                }
-                
-                // Verificar se é número
-                if (operand_result.value.type != VAL_NUMBER) {
-                    if (current_lang == LANG_PT)
-                        return create_error_result("Operações unárias requerem números");
-                    else 
-                        return create_error_result("Unary operations require numbers");
-                }
-                
-                double result;
-                switch (node->operator) {
-                    case '-': result = -operand_result.value.number; break;
-                    case '!': result = factorial(operand_result.value.number); break;
-                    default: 
-                        if (current_lang == LANG_PT)
-                            return create_error_result("Operador unário inválido");
-                        else 
-                            return create_error_result("Invalid unary operator");
-                }
-                return create_success_result(create_number_value(result), 0);
-            }
-            
-        case NODE_FUNCTION:  
-            {
-                if(!strcmp(node->function, "print") && (node->args == NULL || node->arg_count == 0 )){
-                    return execute_function(state, node->function, NULL,0);
-                }
-
-                if(!strcmp(node->function, "clear") && (node->args == NULL || node->arg_count == 0 )){
-                    return execute_function(state, node->function, NULL,0);
-                }
 
-
-                if (node->args == NULL || node->arg_count == 0 ) {
-                    if (current_lang == LANG_PT)
-                        return create_error_result("Função sem argumentos");
-                    else 
-                        return create_error_result("Function without arguments");
-                }
-                
-                // Avalia todos os argumentos
-                Value* arg_values = (Value*)A89ALLOC(node->arg_count * sizeof(Value));
-                if (!arg_values) {
-                    if (current_lang == LANG_PT)
-                        return create_error_result("Falha de alocação de memória");
-                    else 
-                        return create_error_result("Memory allocation failed");
-                }
-                
-                for (int i = 0; i < node->arg_count; i++) {
-                    EvaluatorResult arg_result = evaluate(state, node->args[i]);
-                    if (!arg_result.success) {
-                        a89free(arg_values);
-                        return arg_result;
-                    }
-                    arg_values[i] = arg_result.value;
-                }
-                
-                // Executa a função
-                EvaluatorResult func_result = execute_function(state, node->function, arg_values, node->arg_count);
-                
-                // Libera memória
-                a89free(arg_values);
-                
-                return func_result;
-            }
-
-        case NODE_SEQUENCE:
-            {
-                Value last_value = create_null_value();
-                int has_value = 0;  // Flag para saber se algum statement retornou valor
-                
-                // Executar todos os statements em sequência
-                for (int i = 0; i < node->stmt_count; i++) {
-                    EvaluatorResult stmt_result = evaluate(state, node->statements[i]);
-                    
-                    if (!stmt_result.success) {
-                        return stmt_result;  // Propagação de erro
-                    }
-                    
-                    // Armazenar o último valor não-nulo (que não seja de atribuição)
-                    if (!stmt_result.is_assignment) {
-                        last_value = stmt_result.value;
-                        has_value = 1;
-                    }
-                }
-                
-                if (has_value) {
-                    return create_success_result(last_value, 0);
-                } else {
-                    // Se todos foram assignments, retorna sucesso sem valor
-                    return create_success_result(create_null_value(), 1);
-                }
-            }
-            
-        default:
-            if (current_lang == LANG_PT)
-                return create_error_result("Tipo de nó AST desconhecido");
-            else 
-                return create_error_result("Unknown AST node type");
+// Hash FNV-1a do nome da variável
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;
+    while (*name) {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
     }
+    return hash;
 }
 
-/*
- * EXECUÇÃO DE FUNÇÕES
- */
-EvaluatorResult execute_function(EvaluatorState* state, const char* function_name, 
-                                 Value* arg_values, int arg_count) {
-    double result;
-    char error_msg[STR_SIZE];
+// Copia o nome para os blocos de nomes internados
+static const char* intern_name(EvaluatorState* state, const char* name) {
+    size_t len = strlen(name) + 1;
+    NameChunk* chunk = state->names;
+
+    if (chunk == NULL || chunk->size - chunk->used < len) {
+        size_t size = len > NAME_CHUNK_SIZE ? len : NAME_CHUNK_SIZE;
+        chunk = (NameChunk*)A89ALLOC(sizeof(NameChunk) + size);
+        if (!chunk) return NULL;
+        chunk->next = state->names;
+        chunk->used = 0;
+        chunk->size = size;
+        state->names = chunk;
+    }
+
+    char* copy = chunk->data + chunk->used;
+    memcpy(copy, name, len);
+    chunk->used += len;
+    return copy;
+}
 
-    // ============ FUNÇÃO PRINT ============
-    if (strcmp(function_name, "print") == 0) {
-        if (arg_count < 1) {
-            printf("\n");
-            return create_success_result(create_null_value(), 1); // Sucesso silencioso           
-        }
-        
-        // Processa cada argumento do print
-        for (int i = 0; i < arg_count; i++) {
-            print_value(arg_values[i], state->decimal_places); 
-            if (i < arg_count - 1) printf(" ");
-        }
-        printf("\n");
-        
-        return create_success_result(create_null_value(), 1); // Sucesso silencioso
-    }
+// Reconstrói o índice hash com o novo tamanho (potência de 2)
+static int rebuild_buckets(EvaluatorState* state, int new_count) {
+    int* new_buckets = (int*)A89ALLOC(new_count * sizeof(int));
+    if (!new_buckets) return 0;
+    memset(new_buckets, 0, new_count * sizeof(int));
 
-    // ============ FUNÇÃO CLEAR ============
-    if (strcmp(function_name, "clear") == 0) {
-        if (arg_count != 0) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função clear não requer argumentos");
-            else 
-                return create_error_result("Function clear does not require arguments");   
-        }        
-        clear_screen();
-        return create_success_result(create_null_value(), 1); // Sucesso silencioso
-    }
-
-    // ============ FUNÇÕES DE ALINHAMENTO ============
-    if (strcmp(function_name, "left") == 0) {
-        return create_success_result(left(arg_values, arg_count),0);
+    unsigned int mask = (unsigned int)new_count - 1;
+    for (int i = 0; i < state->variable_count; i++) {
+        unsigned int pos = state->variables[i].hash & mask;
+        while (new_buckets[pos] != 0) {
+            pos = (pos + 1) & mask;
+        }
+        new_buckets[pos] = i + 1;
     }
 
-    if (strcmp(function_name, "center") == 0) {
-        return create_success_result(center(arg_values, arg_count),0);
-    }
+    a89free(state->buckets);
+    state->buckets = new_buckets;
+    state->bucket_count = new_count;
+    return 1;
+}
 
-    if (strcmp(function_name, "right") == 0) {
-        return create_success_result(right(arg_values, arg_count),0);
-    }
+// Garante espaço para mais uma variável (vetor, slots e índice)
+static int reserve_variable(EvaluatorState* state) {
+    if (state->variable_count >= state->variable_capacity) {
+        int new_capacity = state->variable_capacity ? state->variable_capacity * 2
+                                                    : INITIAL_VARIABLE_CAPACITY;
+        Variable* new_variables = (Variable*)A89ALLOC(new_capacity * sizeof(Variable));
+        Value* new_slots = (Value*)A89ALLOC(new_capacity * sizeof(Value));
+        if (!new_variables || !new_slots) {
+            a89free(new_variables);
+            a89free(new_slots);
+            return 0;
+        }
+        if (state->variables != NULL) {
+            memcpy(new_variables, state->variables, state->variable_count * sizeof(Variable));
+            memcpy(new_slots, state->slots, state->variable_count * sizeof(Value));
+            a89free(state->variables);
+            a89free(state->slots);
+        }
+        state->variables = new_variables;
+        state->slots = new_slots;
+        state->variable_capacity = new_capacity;
+    }
+
+    // Mantém a ocupação do índice abaixo de 50%
+    if ((state->variable_count + 1) * 2 > state->bucket_count) {
+        int new_count = state->bucket_count ? state->bucket_count * 2
+                                            : INITIAL_VARIABLE_CAPACITY * 2;
+        if (!rebuild_buckets(state, new_count)) return 0;
+    }
+    return 1;
+}
 
-    // ============ FUNÇÃO REPEAT ============
-    if (strcmp(function_name, "repeat") == 0) {
-        if (arg_count != 2) {
-            Value error;
-            error.type = VAL_STRING;
-            if (current_lang == LANG_PT) {
-                // snprintf(error.string, STR_SIZE,
-                //          "Erro: repeat requer exatamente 2 argumentos");
-                return create_error_result("Função repeat requer exatamente 2 argumentos");;
-            } else {
-                // snprintf(error.string, STR_SIZE,
-                //          "Error: repeat requires exactly 2 arguments");
-                return create_error_result("Function repeat requires exactly 2 arguments");;
+int lookup_variable(EvaluatorState* state, const char* variable_name, int create) {
+    unsigned int hash = hash_name(variable_name);
+
+    if (state->bucket_count > 0) {
+        unsigned int mask = (unsigned int)state->bucket_count - 1;
+        unsigned int pos = hash & mask;
+        while (state->buckets[pos] != 0) {
+            int index = state->buckets[pos] - 1;
+            Variable* var = &state->variables[index];
+            if (var->hash == hash && strcmp(var->name, variable_name) == 0) {
+                return index;
             }
+            pos = (pos + 1) & mask;
         }
-        Value v = repeat(create_string_value(arg_values[0].string),
-                         create_number_value(arg_values[1].number));
-        return create_success_result(v,0);
     }
 
-    // ============ FUNÇÕES DE CORES ============
-    if (strcmp(function_name, "black") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função black requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function black requires exactly 1 argument");
-        }
-        return create_success_result(black(arg_values[0]), 0);
-    }
+    if (!create) return -1;
 
-    if (strcmp(function_name, "red") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função red requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function red requires exactly 1 argument");
-        }
-        return create_success_result(red(arg_values[0]), 0);
-    }
+    // Não encontrada: cria nova entrada com nome internado
+    if (!reserve_variable(state)) return -1;
 
-    if (strcmp(function_name, "green") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função green requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function green requires exactly 1 argument");
-        }
-        return create_success_result(green(arg_values[0]), 0);
-    }
+    const char* name = intern_name(state, variable_name);
+    if (!name) return -1;
 
-    if (strcmp(function_name, "yellow") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função yellow requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function yellow requires exactly 1 argument");
-        }
-        return create_success_result(yellow(arg_values[0]), 0);
-    }
+    int index = state->variable_count++;
+    state->variables[index].name = name;
+    state->variables[index].hash = hash;
+    state->slots[index] = create_undefined_value();
 
-    if (strcmp(function_name, "blue") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função blue requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function blue requires exactly 1 argument");
-        }
-        return create_success_result(blue(arg_values[0]), 0);
+    unsigned int mask = (unsigned int)state->bucket_count - 1;
+    unsigned int pos = hash & mask;
+    while (state->buckets[pos] != 0) {
+        pos = (pos + 1) & mask;
     }
+    state->buckets[pos] = index + 1;
 
-    if (strcmp(function_name, "magenta") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função magenta requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function magenta requires exactly 1 argument");
-        }
-        return create_success_result(magenta(arg_values[0]), 0);
-    }
+    return index;
+}
 
-    if (strcmp(function_name, "cyan") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função cyan requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function cyan requires exactly 1 argument");
-        }
-        return create_success_result(cyan(arg_values[0]), 0);
+Value get_variable(EvaluatorState* state, const char* variable_name) {
+    int slot = lookup_variable(state, variable_name, 0);
+    if (slot >= 0 && state->slots[slot].type != VAL_UNDEFINED) {
+        return value_retain(state->slots[slot]);
     }
+    return create_null_value(); // Retorna null
+}
 
-    if (strcmp(function_name, "white") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função white requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function white requires exactly 1 argument");
-        }
-        return create_success_result(white(arg_values[0]), 0);
-    }
+void set_variable(EvaluatorState* state, const char* variable_name, Value value) {
+    int slot = lookup_variable(state, variable_name, 1);
+    if (slot < 0) return;
+    value_release(&state->slots[slot]);
+    state->slots[slot] = value_retain(value);
+}
 
-    if (strcmp(function_name, "bright_black") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_black requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_black requires exactly 1 argument");
-        }
-        return create_success_result(bright_black(arg_values[0]), 0);
-    }
+int variable_exists(EvaluatorState* state, const char* variable_name) {
+    int slot = lookup_variable(state, variable_name, 0);
+    return slot >= 0 && state->slots[slot].type != VAL_UNDEFINED;
+}
 
-    if (strcmp(function_name, "bright_red") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_red requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_red requires exactly 1 argument");
-        }
-        return create_success_result(bright_red(arg_values[0]), 0);
-    }
+//===================================================================
+// RESOLUÇÃO DE VARIÁVEIS (nome -> slot)
+//===================================================================
+void resolve_variables(EvaluatorState* state, ASTNode* node) {
+    ASTWalk walk;
+    int leaving;
 
-    if (strcmp(function_name, "bright_green") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_green requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_green requires exactly 1 argument");
+    // Na entrada de cada nó: os slots são criados na ordem do código
+    // (a variável atribuída antes das usadas no valor)
+    ast_walk_begin(&walk, node);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (leaving) continue;
+        if ((node->type == NODE_VARIABLE || node->type == NODE_ASSIGNMENT) &&
+            node->as.variable.slot < 0) {
+            node->as.variable.slot = lookup_variable(state, node->as.variable.name, 1);
         }
-        return create_success_result(bright_green(arg_values[0]), 0);
     }
+    ast_walk_end(&walk);
+}
 
-    if (strcmp(function_name, "bright_yellow") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_yellow requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_yellow requires exactly 1 argument");
-        }
-        return create_success_result(bright_yellow(arg_values[0]), 0);
+void print_variables(EvaluatorState* state) {
+    output_string("=== Variáveis no estado ===\n");
+    
+    int count = 0;
+    
+    for (int i = 0; i < state->variable_count; i++) {
+        if (state->slots[i].type == VAL_UNDEFINED) continue;
+        output_printf("%d. %s: ", ++count, state->variables[i].name);
+        print_value(state->slots[i], state->decimal_places); 
+        output_char('\n');
     }
-
-    if (strcmp(function_name, "bright_blue") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_blue requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_blue requires exactly 1 argument");
-        }
-        return create_success_result(bright_blue(arg_values[0]), 0);
+    
+    if (count == 0) {
+        output_string("Nenhuma variável definida\n");
     }
+    output_string("===========================\n");
+}
 
-    if (strcmp(function_name, "bright_magenta") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_magenta requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_magenta requires exactly 1 argument");
-        }
-        return create_success_result(bright_magenta(arg_values[0]), 0);
-    }
+EvaluatorResult create_success_result(Value value, int is_assignment) {
+    EvaluatorResult result;
+    result.success = 1;
+    result.is_assignment = is_assignment;
+    result.value = value;
+    return result;
+}
 
-    if (strcmp(function_name, "bright_cyan") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_cyan requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_cyan requires exactly 1 argument");
-        }
-        return create_success_result(bright_cyan(arg_values[0]), 0);
-    }
+EvaluatorResult create_error_result(EvaluatorState* state, const char* message) {
+    EvaluatorResult result;
+    result.success = 0;
+    result.is_assignment = 0;
+    result.value = create_null_value();
 
-    if (strcmp(function_name, "bright_white") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bright_white requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bright_white requires exactly 1 argument");
-        }
-        return create_success_result(bright_white(arg_values[0]), 0);
-    }
+    strncpy(state->error.message, message, sizeof(state->error.message) - 1);
+    state->error.message[sizeof(state->error.message) - 1] = '\0';
+    state->error.node = NULL;
+    state->error.position = -1;
+    return result;
+}
 
-    if (strcmp(function_name, "bg_black") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_black requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_black requires exactly 1 argument");
-        }
-        return create_success_result(bg_black(arg_values[0]), 0);
-    }
+// Erro associado a um nó da AST
+static EvaluatorResult node_error_result(EvaluatorState* state, ASTNode* node, const char* message) {
+    EvaluatorResult result = create_error_result(state, message);
+    state->error.node = node;
+    state->error.position = node ? node->position : -1;
+    return result;
+}
 
-    if (strcmp(function_name, "bg_red") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_red requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_red requires exactly 1 argument");
-        }
-        return create_success_result(bg_red(arg_values[0]), 0);
-    }
+//===================================================================
+// AVALIA A AST
+//===================================================================
+/*
+ * Avalia uma expressão sem recursão: ast_walk_next() entrega os nós em
+ * pós-ordem (filhos antes do pai) e cada nó consome os valores dos
+ * filhos do topo de state->stack e empilha o seu resultado, como a VM.
+ * A profundidade da expressão fica limitada pelo heap.
+ */
+static EvaluatorResult evaluate_expression(EvaluatorState* state, ASTNode* root) {
+    int base = state->stack_top;
+    int is_assignment = 0;
+    EvaluatorResult result;
+    ASTWalk walk;
+    ASTNode* node;
+    int leaving;
 
-    if (strcmp(function_name, "bg_green") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_green requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_green requires exactly 1 argument");
-        }
-        return create_success_result(bg_green(arg_values[0]), 0);
-    }
+    ast_walk_begin(&walk, root);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (!leaving) continue;
 
-    if (strcmp(function_name, "bg_yellow") == 0) {
-        if (arg_count != 1) {
+        if (!reserve_stack(state)) {
             if (current_lang == LANG_PT)
-                return create_error_result("Função bg_yellow requer exatamente 1 argumento");
+                result = node_error_result(state, node, "Falha de alocação de memória");
             else 
-                return create_error_result("Function bg_yellow requires exactly 1 argument");
+                result = node_error_result(state, node, "Memory allocation failed");
+            goto error;
         }
-        return create_success_result(bg_yellow(arg_values[0]), 0);
-    }
+        // Primeira posição livre; os valores dos filhos estão logo abaixo
+        Value* top = state->stack + state->stack_top;
+        is_assignment = 0;
 
-    if (strcmp(function_name, "bg_blue") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_blue requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_blue requires exactly 1 argument");
-        }
-        return create_success_result(bg_blue(arg_values[0]), 0);
-    }
+        switch (node->type) {
+            case NODE_NUMBER:
+                *top = node->as.value;
+                state->stack_top++;
+                break;
 
-    if (strcmp(function_name, "bg_magenta") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_magenta requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_magenta requires exactly 1 argument");
-        }
-        return create_success_result(bg_magenta(arg_values[0]), 0);
-    }
+            case NODE_STRING:
+                *top = value_retain(node->as.value);
+                state->stack_top++;
+                break;
 
-    if (strcmp(function_name, "bg_cyan") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_cyan requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_cyan requires exactly 1 argument");
-        }
-        return create_success_result(bg_cyan(arg_values[0]), 0);
-    }
+            case NODE_VARIABLE:
+                {
+                    // Nó não resolvido (evaluate chamado sem resolve_variables)
+                    if (node->as.variable.slot < 0) {
+                        node->as.variable.slot = lookup_variable(state, node->as.variable.name, 1);
+                    }
+                    if (node->as.variable.slot < 0 ||
+                        state->slots[node->as.variable.slot].type == VAL_UNDEFINED) {
+                        if (current_lang == LANG_PT)
+                            result = node_error_result(state, node, "Variável não definida");
+                        else 
+                            result = node_error_result(state, node, "Variable not defined");
+                        goto error;
+                    }
+                    *top = value_retain(state->slots[node->as.variable.slot]);
+                    state->stack_top++;
+                }
+                break;
+
+            case NODE_ASSIGNMENT:
+                {
+                    // O valor atribuído continua na pilha como resultado
+                    if (node->as.variable.slot < 0) {
+                        node->as.variable.slot = lookup_variable(state, node->as.variable.name, 1);
+                        if (node->as.variable.slot < 0) {
+                            if (current_lang == LANG_PT)
+                                result = node_error_result(state, node, "Falha de alocação de memória");
+                            else 
+                                result = node_error_result(state, node, "Memory allocation failed");
+                            goto error;
+                        }
+                    }
+                    value_release(&state->slots[node->as.variable.slot]);
+                    state->slots[node->as.variable.slot] = value_retain(top[-1]);
+                    is_assignment = 1;
+                }
+                break;
 
-    if (strcmp(function_name, "bg_white") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_white requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_white requires exactly 1 argument");
-        }
-        return create_success_result(bg_white(arg_values[0]), 0);
-    }
+            case NODE_BINARY_OP:
+                {
+                    Value* left = &top[-2];
+                    Value* right = &top[-1];
 
-    if (strcmp(function_name, "bg_bright_black") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_black requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_black requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_black(arg_values[0]), 0);
-    }
+                    if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
+                        NumberStatus status = number_binary(node->operator, left, *right);
+                        if (status == NUMBER_INVALID_OPERATOR) {
+                            if (current_lang == LANG_PT)
+                                result = node_error_result(state, node, "Operador binário inválido");
+                            else 
+                                result = node_error_result(state, node, "Invalid binary operator");
+                            goto error;
+                        }
+                        if (status != NUMBER_OK) {
+                            result = node_error_result(state, node, number_error_message(status));
+                            goto error;
+                        }
+                    } else if (node->operator == '+') {
+                        EvaluatorResult left_result = create_success_result(*left, 0);
+                        EvaluatorResult right_result = create_success_result(*right, 0);
+                        EvaluatorResult concat = string_concatenate(&left_result, &right_result, -1);
+                        value_release(left);
+                        value_release(right);
+                        *left = concat.value;
+                    } else if (is_bitwise_operator(node->operator)) {
+                        result = node_error_result(state, node, number_error_message(NUMBER_NOT_INTEGER));
+                        goto error;
+                    } else {
+                        // Outros operadores com strings → ERRO
+                        if (current_lang == LANG_PT)
+                            result = node_error_result(state, node, "Operações aritméticas requerem números");
+                        else 
+                            result = node_error_result(state, node, "Arithmetic operations require numbers");
+                        goto error;
+                    }
+                    state->stack_top--;
+                }
+                break;
+
+            case NODE_CONCAT:
+                {
+                    int parts_base = state->stack_top - node->as.concat.count;
+                    Value concat = concatenate_values(state->stack + parts_base,
+                                                      node->as.concat.count, -1);
+                    pop_stack(state, parts_base);
+                    state->stack[state->stack_top++] = concat;
+                }
+                break;
 
-    if (strcmp(function_name, "bg_bright_red") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_red requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_red requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_red(arg_values[0]), 0);
-    }
+            case NODE_UNARY_OP:
+                {
+                    Value* operand = &top[-1];
 
-    if (strcmp(function_name, "bg_bright_green") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_green requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_green requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_green(arg_values[0]), 0);
-    }
+                    // Verificar se é número
+                    if (operand->type != VAL_NUMBER) {
+                        if (current_lang == LANG_PT)
+                            result = node_error_result(state, node, "Operações unárias requerem números");
+                        else 
+                            result = node_error_result(state, node, "Unary operations require numbers");
+                        goto error;
+                    }
 
-    if (strcmp(function_name, "bg_bright_yellow") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_yellow requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_yellow requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_yellow(arg_values[0]), 0);
-    }
+                    NumberStatus status = number_unary(node->operator, operand);
+                    if (status == NUMBER_INVALID_OPERATOR) {
+                        if (current_lang == LANG_PT)
+                            result = node_error_result(state, node, "Operador unário inválido");
+                        else 
+                            result = node_error_result(state, node, "Invalid unary operator");
+                        goto error;
+                    }
+                    if (status != NUMBER_OK) {
+                        result = node_error_result(state, node, number_error_message(status));
+                        goto error;
+                    }
+                }
+                break;
+
+            case NODE_FUNCTION:
+                {
+                    // Os argumentos já estão contíguos no topo da pilha
+                    int args_base = state->stack_top - node->as.call.arg_count;
+                    EvaluatorResult func_result = execute_function(state, node->as.call.builtin_id,
+                                                                   state->stack + args_base,
+                                                                   node->as.call.arg_count);
+                    pop_stack(state, args_base);
+                    if (!func_result.success) {
+                        if (state->error.node == NULL) {
+                            state->error.node = node;
+                            state->error.position = node->position;
+                        }
+                        result = func_result;
+                        goto error;
+                    }
+                    state->stack[state->stack_top++] = func_result.value;
+                    is_assignment = func_result.is_assignment;
+                }
+                break;
+
+            case NODE_SEQUENCE:
+                {
+                    // Sequência dentro de uma expressão: vale o último statement
+                    int statements_base = state->stack_top - node->as.sequence.count;
+                    Value last_value = create_null_value();
+                    if (node->as.sequence.count > 0) {
+                        last_value = state->stack[--state->stack_top];
+                    }
+                    pop_stack(state, statements_base);
+                    state->stack[state->stack_top++] = last_value;
+                }
+                break;
 
-    if (strcmp(function_name, "bg_bright_blue") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_blue requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_blue requires exactly 1 argument");
+            default:
+                if (current_lang == LANG_PT)
+                    result = node_error_result(state, node, "Tipo de nó AST desconhecido");
+                else 
+                    result = node_error_result(state, node, "Unknown AST node type");
+                goto error;
         }
-        return create_success_result(bg_bright_blue(arg_values[0]), 0);
     }
 
-    if (strcmp(function_name, "bg_bright_magenta") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_magenta requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_magenta requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_magenta(arg_values[0]), 0);
+    if (walk.error == AST_WALK_NULL_CHILD) {
+        if (current_lang == LANG_PT)
+            result = node_error_result(state, NULL, "Nó AST nulo");
+        else 
+            result = node_error_result(state, NULL, "Null AST node");
+        goto error;
     }
-
-    if (strcmp(function_name, "bg_bright_cyan") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_cyan requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_cyan requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_cyan(arg_values[0]), 0);
+    if (walk.error == AST_WALK_NO_MEMORY) {
+        if (current_lang == LANG_PT)
+            result = node_error_result(state, NULL, "Falha de alocação de memória");
+        else 
+            result = node_error_result(state, NULL, "Memory allocation failed");
+        goto error;
     }
+    ast_walk_end(&walk);
 
-    if (strcmp(function_name, "bg_bright_white") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bg_bright_white requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bg_bright_white requires exactly 1 argument");
-        }
-        return create_success_result(bg_bright_white(arg_values[0]), 0);
-    }
+    // O resultado é o único valor acima de base
+    return create_success_result(state->stack[--state->stack_top], is_assignment);
 
-    if (strcmp(function_name, "bold") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função bold requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function bold requires exactly 1 argument");
-        }
-        return create_success_result(bold(arg_values[0]), 0);
-    }
+error:
+    ast_walk_end(&walk);
+    pop_stack(state, base);
+    return result;
+}
 
-    if (strcmp(function_name, "dim") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função dim requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function dim requires exactly 1 argument");
-        }
-        return create_success_result(dim(arg_values[0]), 0);
+EvaluatorResult evaluate(EvaluatorState* state, ASTNode* node) {
+    if (node == NULL) {
+        if(current_lang == LANG_PT)
+            return node_error_result(state, node, "Nó AST nulo");
+        else 
+            return node_error_result(state, node, "Null AST node");
     }
-
-    if (strcmp(function_name, "italic") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função italic requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function italic requires exactly 1 argument");
-        }
-        return create_success_result(italic(arg_values[0]), 0);
+    
+    if (node->type != NODE_SEQUENCE) {
+        return evaluate_expression(state, node);
     }
 
-    if (strcmp(function_name, "underline") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função underline requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function underline requires exactly 1 argument");
+    Value last_value = create_null_value();
+    int has_value = 0;  // Flag para saber se algum statement retornou valor
+    
+    // Executar todos os statements em sequência
+    for (int i = 0; i < node->as.sequence.count; i++) {
+        EvaluatorResult stmt_result = evaluate(state, node->as.sequence.statements[i]);
+        
+        if (!stmt_result.success) {
+            value_release(&last_value);
+            return stmt_result;  // Propagação de erro
         }
-        return create_success_result(underline(arg_values[0]), 0);
-    }
-
-    if (strcmp(function_name, "blink") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função blink requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function blink requires exactly 1 argument");
+        
+        // Armazenar o último valor não-nulo (que não seja de atribuição)
+        if (!stmt_result.is_assignment) {
+            value_release(&last_value);
+            last_value = stmt_result.value;
+            has_value = 1;
+        } else {
+            value_release(&stmt_result.value);
         }
-        return create_success_result(blink(arg_values[0]), 0);
     }
-
-    if (strcmp(function_name, "inverse") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função inverse requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function inverse requires exactly 1 argument");
-        }
-        return create_success_result(inverse(arg_values[0]), 0);
+    
+    if (has_value) {
+        return create_success_result(last_value, 0);
+    } else {
+        // Se todos foram assignments, retorna sucesso sem valor
+        return create_success_result(create_null_value(), 1);
     }
+}
 
-    if (strcmp(function_name, "hidden") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função hidden requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function hidden requires exactly 1 argument");
-        }
-        return create_success_result(hidden(arg_values[0]), 0);
+/*
+ * EXECUÇÃO DE FUNÇÕES
+ *
+ * O ID vem do lexer (builtin_lookup) e foi gravado no nó pelo parser:
+ * valida aridade e tipos pela tabela e despacha com uma única chamada
+ * indireta ao handler.
+ */
+EvaluatorResult execute_function(EvaluatorState* state, int builtin_id,
+                                 Value* arg_values, int arg_count) {
+    char error_msg[STR_SIZE];
+
+    if (builtin_id < 0 || builtin_id >= BUILTIN_COUNT) {
+        build_unknown_function_msg(error_msg, sizeof(error_msg), "?");
+        return create_error_result(state, error_msg);
     }
 
-    if (strcmp(function_name, "strikethrough") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT)
-                return create_error_result("Função strikethrough requer exatamente 1 argumento");
-            else 
-                return create_error_result("Function strikethrough requires exactly 1 argument");
-        }
-        return create_success_result(strikethrough(arg_values[0]), 0);
+    const BuiltinInfo* info = &builtin_table[builtin_id];
+
+    if (!builtin_check_arity(builtin_id, arg_count, error_msg, sizeof(error_msg))) {
+        return create_error_result(state, error_msg);
     }
 
-    // ============ VERIFICAR ARGUMENTOS PARA FUNÇÕES MATEMÁTICAS ============
-    for (int i = 0; i < arg_count; i++) {
-        if (arg_values[i].type != VAL_NUMBER) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), 
-                         "Função %s requer argumentos numéricos", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), 
-                         "Function %s requires numeric arguments", function_name);
+    if (info->arg_kind == ARGS_NUMBERS) {
+        for (int i = 0; i < arg_count; i++) {
+            if (arg_values[i].type != VAL_NUMBER) {
+                if (current_lang == LANG_PT) {
+                    snprintf(error_msg, sizeof(error_msg), 
+                             "Função %s requer argumentos numéricos", info->name);
+                } else {
+                    snprintf(error_msg, sizeof(error_msg), 
+                             "Function %s requires numeric arguments", info->name);
+                }
+                return create_error_result(state, error_msg);
             }
-            return create_error_result(error_msg);
         }
     }
-    
-    // Converter Value[] para double[]
-    double* double_args = A89ALLOC(arg_count * sizeof(double));
-    if (!double_args) {
-        if (current_lang == LANG_PT)
-            return create_error_result("Falha de alocação de memória para double_args");
-        else 
-            return create_error_result("Memory allocation failed for double_args");
-    }
-    
-    for (int i = 0; i < arg_count; i++) {
-        double_args[i] = arg_values[i].number;
-    }
 
-    // ============ FUNÇÕES MATEMÁTICAS ============
-    if (strcmp(function_name, "sqrt") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "sqrt", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_sqrt(double_args[0]);
-    }
-    else if (strcmp(function_name, "sin") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "sin", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_sin(double_args[0]);
-    }
-    else if (strcmp(function_name, "cos") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "cos", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_cos(double_args[0]);
-    }
-    else if (strcmp(function_name, "tan") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "tan", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_tan(double_args[0]);
-    }
-    else if (strcmp(function_name, "log") == 0){
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "log", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_log10(double_args[0]);
-    }
-    else if (strcmp(function_name, "ln") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "ln", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_ln(double_args[0]);
-    }
-    else if (strcmp(function_name, "exp") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "exp", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_exp(double_args[0]);
-    }
-    else if (strcmp(function_name, "abs") == 0) {
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "abs", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_abs(double_args[0]);
-    }
-    
-    // ============ FUNÇÕES ESTATÍSTICAS ============
-    else if (strcmp(function_name, "mean") == 0) {
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "mean", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_mean(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "median") == 0) {
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "median", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_median(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "std") == 0) {
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "std", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_std(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "variance") == 0){
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "variance", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_variance(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "mode") == 0){
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "mode", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_mode(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "sum") == 0){
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "sum", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_sum(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "min") == 0){
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "min", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_min(double_args, arg_count);
-    }
-    else if (strcmp(function_name, "max") == 0){
-        if (arg_count < 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "max", 1, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_max(double_args, arg_count);
-    }
-    
-    // ============ FUNÇÕES FINANCEIRAS ============
-    else if (strcmp(function_name, "pv") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "pv", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_pv(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "fv") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "fv", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_fv(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "pmt") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "pmt", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_pmt(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "nper") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "nper", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_nper(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "rate") == 0){
-        if (arg_count != 4) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "rate", 4, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_rate(double_args[0], double_args[1], double_args[2], double_args[3]);
-    }
-    else if (strcmp(function_name, "si") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "si", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_simple_interest(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "fv_si") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "fv_si", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_simple_amount(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "ci") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "ci", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_compound_interest(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "fv_ci") == 0){
-        if (arg_count != 3) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "fv_ci", 3, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        result = math_compound_amount(double_args[0], double_args[1], double_args[2]);
-    }
-    else if (strcmp(function_name, "npv") == 0){
-        if (arg_count < 2) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "npv", 2, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        // Primeiro argumento é a taxa, os demais são fluxos de caixa
-        double rate = double_args[0];
-        double* cashflows = &double_args[1];
-        int cf_count = arg_count - 1;
-        result = math_npv(rate, cashflows, cf_count);
-    }
-    else if (strcmp(function_name, "irr") == 0){
-        if (arg_count < 2) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "irr", 2, 1);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        // Todos os argumentos são fluxos de caixa
-        double guess = 0.1; // Chute inicial padrão
-        result = math_irr(double_args, arg_count, guess);
-    }
-    // ============ FUNÇÕES DE CONFIGURAÇÃO ============ 
-    else if (strcmp(function_name, "setdec") == 0) {
-        // Implementação do setdec
-        if (arg_count != 1) {
-            build_arg_error_msg(error_msg, sizeof(error_msg), "setdec", 1, 0);
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        
-        int places = (int)double_args[0];
-        if (places < 0 || places > 15) {
-            if (current_lang == LANG_PT)
-                snprintf(error_msg, sizeof(error_msg), "setdec: número de casas deve estar entre 0 e 15");
-            else 
-                snprintf(error_msg, sizeof(error_msg), "setdec: number of places must be between 0 and 15");
-            a89free(double_args);
-            return create_error_result(error_msg);
-        }
-        
-        state->decimal_places = places;
-        a89free(double_args);
-        return create_success_result(create_number_value(0.0), 1); // Sucesso silencioso
-    }
-    else {
-        build_unknown_function_msg(error_msg, sizeof(error_msg), function_name);
-        a89free(double_args);
-        return create_error_result(error_msg);
-    }
-    
-    // Liberar memória
-    a89free(double_args);
-    
-    // Verifica se resultado é NAN
-    if (isnan(result)) {
-        build_math_error_msg(error_msg, sizeof(error_msg), function_name);
-        return create_error_result(error_msg);
-    }
-    
-    return create_success_result(create_number_value(result), 0);
+    return info->handler(state, arg_values, arg_count);
 }
 
 //===================================================================
@@ -1084,44 +642,70 @@ EvaluatorResult execute_function(EvaluatorState* state, const char* function_nam
 EvaluatorResult string_concatenate(EvaluatorResult* left, 
                                    EvaluatorResult* right,
                                    int decimal_places) {
-    EvaluatorResult result;
-
-    // Converter left para string
-    Value left_str_val = value_to_string_value(left->value, decimal_places);
+    // Converter left e right para string
+    Value left_str_val = value_to_plain_string(left->value, decimal_places);
+    Value right_str_val = value_to_plain_string(right->value, decimal_places);
     
-    // Converter right para string  
-    Value right_str_val = value_to_string_value(right->value, decimal_places);
+    // Calcular tamanho total (sem limite: o resultado é alocado sob medida)
+    int left_len = value_length(&left_str_val);
+    int right_len = value_length(&right_str_val);
     
-    // Calcular tamanho total
-    size_t left_len = strlen(left_str_val.string);
-    size_t right_len = strlen(right_str_val.string);
-    size_t total_len = left_len + right_len;
+    Value concat;
+    char* data = create_string_buffer(&concat, left_len + right_len);
+    if (value_length(&concat) == left_len + right_len) {
+        memcpy(data, value_string(&left_str_val), left_len);
+        memcpy(data + left_len, value_string(&right_str_val), right_len);
+    }
     
-    // Buffer para resultado
-    char result_str[STR_SIZE];
+    value_release(&left_str_val);
+    value_release(&right_str_val);
     
-    if (total_len >= STR_SIZE) {
-        // Resultado muito grande - truncar
-        // Primeiro copiar left (até onde couber)
-        strncpy(result_str, left_str_val.string, STR_SIZE - 1);
-        result_str[STR_SIZE - 1] = '\0';
-        
-        // Se ainda houver espaço, adicionar parte do right
-        size_t used = strlen(result_str);
-        if (used < STR_SIZE - 1) {
-            strncat(result_str, right_str_val.string, STR_SIZE - used - 1);
+    return create_success_result(concat, 0);
+}
+
+/*
+ * Mesmo resultado que ((parts[0] + parts[1]) + parts[2]) + ...: os
+ * números do início são somados até o primeiro operando que não é
+ * número; dali em diante cada '+' concatena. Cada operando do trecho
+ * de texto é convertido uma vez (no próprio parts), o resultado é
+ * alocado com a soma dos tamanhos e os textos são copiados em uma
+ * passada, sem os resultados intermediários de string_concatenate.
+ */
+Value concatenate_values(Value* parts, int count, int decimal_places) {
+    if (count <= 0) return create_null_value();
+
+    int first = 0;
+    while (first + 1 < count && parts[first].type == VAL_NUMBER &&
+           parts[first + 1].type == VAL_NUMBER) {
+        number_add(&parts[first], parts[first + 1]);
+        parts[first + 1] = parts[first];
+        first++;
+    }
+    if (first == count - 1) {
+        return value_retain(parts[first]);
+    }
+
+    size_t total = 0;
+    for (int i = first; i < count; i++) {
+        Value text = value_to_plain_string(parts[i], decimal_places);
+        value_release(&parts[i]);
+        parts[i] = text;
+        total += (size_t)value_length(&parts[i]);
+    }
+
+    Value concat;
+    if (total > (size_t)INT_MAX) {
+        // Grande demais para uma string: vazia, como numa falha de alocação
+        create_string_buffer(&concat, 0);
+        return concat;
+    }
+    char* data = create_string_buffer(&concat, (int)total);
+    if ((size_t)value_length(&concat) == total) {
+        for (int i = first; i < count; i++) {
+            int length = value_length(&parts[i]);
+            memcpy(data, value_string(&parts[i]), length);
+            data += length;
         }
-        
-    } else {
-        // Cabe normalmente
-        snprintf(result_str, total_len + 1, "%s%s", 
-                 left_str_val.string, right_str_val.string);
     }
-    
-    // Configurar resultado
-    result.success = 1;
-    result.value = create_string_value(result_str);
-    result.is_assignment = 0;
-    return result;
+    return concat;
 }
-
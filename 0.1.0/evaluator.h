@@ -5,44 +5,105 @@
 #include "value.h"
 #include "parser.h"
 
+// Entrada da tabela de símbolos: o índice da variável em
+// EvaluatorState.variables é também o seu slot em EvaluatorState.slots
 typedef struct Variable {
-    char name[STR_SIZE];
-    Value value;        
-    struct Variable* next;
-    int initialized;        
+    const char* name;       // Nome internado (cópia única, pertence à tabela)
+    unsigned int hash;      // Hash do nome (evita strcmp em colisões)
 } Variable;
 
+// Bloco de memória onde os nomes das variáveis são internados
+typedef struct NameChunk {
+    struct NameChunk* next;
+    size_t used;
+    size_t size;
+    char data[];
+} NameChunk;
+
+/*
+ * DETALHES DO ÚLTIMO ERRO - RUDIS
+ *
+ * Ficam fora do EvaluatorResult para que o retorno de evaluate()
+ * continue pequeno; só são preenchidos quando algo falha.
+ * - message: mensagem de erro
+ * - node: nó da AST onde o erro ocorreu (NULL se desconhecido)
+ * - position: posição do nó no código-fonte (-1 se desconhecida)
+ */
+typedef struct {
+    char message[STR_SIZE];
+    ASTNode* node;
+    int position;
+} EvaluatorError;
+
 /*
  * ESTADO DO AVALIADOR - RUDIS
  * 
  * Mantém o estado global do avaliador:
- * - variables: lista encadeada de variáveis (identificadores completos)
+ * - variables: vetor de variáveis na ordem de criação (listagem determinística)
  * - variable_count: número de variáveis armazenadas
+ * - buckets: tabela hash com endereçamento aberto (sondagem linear).
+ *   Cada posição guarda o índice da variável + 1 (0 = posição vazia).
+ *   bucket_count é sempre potência de 2 e a ocupação fica abaixo de 50%.
+ * - names: blocos onde os nomes ficam internados (uma cópia por nome)
+ * - slots: valores das variáveis, um por entrada de variables. Um slot
+ *   com VAL_UNDEFINED ainda não recebeu atribuição. Os slots são criados
+ *   sob demanda por resolve_variables() e permanecem entre chamadas de
+ *   process_input() no REPL (até o comando reset).
+ * - stack: pilha de valores de evaluate() e da VM. Cada nó empilha o
+ *   seu resultado sobre os dos filhos; uma chamada de função passa ao
+ *   handler um ponteiro emprestado para os argumentos (contíguos no
+ *   topo) e desempilha ao terminar. A pilha só cresce, então chamadas
+ *   em regime não alocam memória.
+ * - numbers: vetor de trabalho com a visão numérica dos argumentos,
+ *   usado pelos handlers que recebem double* (estatísticas, npv, irr)
+ * - error: detalhes do último erro (válidos quando success = 0)
  */
 typedef struct {
-    Variable* variables;    // Lista de variáveis
+    Variable* variables;    // Vetor de variáveis
     int variable_count;     // Contador de variáveis
+    int variable_capacity;  // Capacidade do vetor de variáveis
+    int* buckets;           // Índice hash: nome -> posição em variables
+    int bucket_count;       // Tamanho da tabela hash
+    NameChunk* names;       // Nomes internados (liberados em bloco)
+    Value* slots;           // Valores das variáveis, indexados pelo slot
+    Value* stack;           // Pilha de valores (resultados e argumentos)
+    int stack_top;          // Primeira posição livre da pilha
+    int stack_capacity;     // Capacidade da pilha
+    double* numbers;        // Argumentos numéricos (vetor de trabalho)
+    int numbers_capacity;   // Capacidade de numbers
     int decimal_places;     // Número de casas decimais
+    EvaluatorError error;   // Detalhes do último erro
 } EvaluatorState;
 
 /*
- * RESULTADO DA AVALIAÇÃO - RUDIS
+ * RESULTADO DA AVALIAÇÃO - RUDIS (24 bytes)
  * 
  * Contém o resultado de uma operação:
  * - success: indica se a operação foi bem-sucedida
- * - value: valor numérico do resultado
- * - error_message: mensagem de erro (se success = 0)
  * - is_assignment: indica se foi uma atribuição
  *   (não deve imprimir resultado)
+ * - value: valor do resultado
+ *
+ * Se success = 0, os detalhes do erro estão em EvaluatorState.error.
+ * O value pertence a quem recebe o resultado (ver regras de posse em
+ * value.h) e deve ser solto com value_release().
  */
 typedef struct {
     int success;
-    Value value;
-    char error_message[STR_SIZE];
     int is_assignment;
+    Value value;
 } EvaluatorResult;
 
-// Obtém valor de uma variável
+// Busca uma variável pelo nome e retorna o seu slot; se create for
+// verdadeiro e ela não existir, cria um novo slot (VAL_UNDEFINED).
+// Retorna -1 se não encontrar (ou em falha de alocação).
+int lookup_variable(EvaluatorState* state, const char* variable_name, int create);
+
+// Resolve os nomes de variáveis da AST para slots (node->slot).
+// Deve ser chamada após parse() e antes de evaluate().
+void resolve_variables(EvaluatorState* state, ASTNode* node);
+
+// Obtém valor de uma variável (nova referência)
 Value get_variable(EvaluatorState* state, const char* variable_name);
 
 // Define valor de uma variável
@@ -63,22 +124,38 @@ void evaluator_init(EvaluatorState* state);
 // Libera a memória do avaliador
 void evaluator_free(EvaluatorState* state);
 
-// Avalia uma AST e retorna o resultado
+// Garante espaço para mais count valores acima de stack_top (a pilha
+// pode ser realocada: ponteiros para ela devem ser obtidos depois)
+int evaluator_reserve_stack(EvaluatorState* state, int count);
+
+// Visão double* dos argumentos (já validados como números), em um
+// vetor de trabalho do estado; válida até a próxima chamada.
+// Retorna NULL em caso de falha de alocação.
+double* evaluator_numbers(EvaluatorState* state, Value* args, int count);
+
+// Avalia uma AST e retorna o resultado (sem recursão: a profundidade
+// da expressão é limitada pelo heap)
 EvaluatorResult evaluate(EvaluatorState* state, ASTNode* node);
 
-// Execução de funções
-EvaluatorResult execute_function(EvaluatorState* state, const char* function_name, 
+// Execução de funções (builtin_id = índice em builtin_table)
+EvaluatorResult execute_function(EvaluatorState* state, int builtin_id,
                                  Value* arg_values, int arg_count);
 
 // Cria resultado de sucesso
 EvaluatorResult create_success_result(Value value, int is_assignment);
 
-// Cria resultado de erro
-EvaluatorResult create_error_result(const char* message);
+// Cria resultado de erro e registra a mensagem em state->error
+EvaluatorResult create_error_result(EvaluatorState* state, const char* message);
 
-// Concatena strings
+// Concatena strings (left e right são apenas emprestados)
 EvaluatorResult string_concatenate(EvaluatorResult* left, 
                                    EvaluatorResult* right,
                                    int decimal_places);
 
-#endif // EVALUATOR_H
\ No newline at end of file
+// Resultado de parts[0] + parts[1] + ... + parts[count - 1], da
+// esquerda para a direita (NODE_CONCAT / OP_CONCAT), com uma única
+// alocação. Os valores de parts continuam pertencendo ao chamador,
+// mas podem ser trocados pelo seu texto.
+Value concatenate_values(Value* parts, int count, int decimal_places);
+
+#endif // EVALUATOR_H
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "format.h"
+#include "output.h"
+#include "lang.h"
+
+#define MAX_FORMAT_PLACES 15        // Mesmo limite de setdec
+#define MAX_FORMAT_WIDTH 100000
+
+typedef struct {
+    Alignment alignment;
+    int width;
+    int places;             // -1 = casas de setdec
+    char kind;              // 's', 'f', 'd' ou '%'
+    int length;             // Bytes da diretiva, incluindo o '%'
+} Directive;
+
+// Lê a diretiva que começa em text[0] == '%'; retorna 0 se inválida
+static int parse_directive(const char* text, const char* end, Directive* directive) {
+    const char* p = text + 1;
+
+    directive->alignment = ALIGN_RIGHT;
+    directive->width = 0;
+    directive->places = -1;
+
+    if (p < end && *p == '-') {
+        directive->alignment = ALIGN_LEFT;
+        p++;
+    } else if (p < end && *p == '^') {
+        directive->alignment = ALIGN_CENTER;
+        p++;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        directive->width = directive->width * 10 + (*p - '0');
+        if (directive->width > MAX_FORMAT_WIDTH) return 0;
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        directive->places = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            directive->places = directive->places * 10 + (*p - '0');
+            if (directive->places > MAX_FORMAT_PLACES) return 0;
+            p++;
+        }
+    }
+    if (p >= end) return 0;
+
+    directive->kind = *p++;
+    directive->length = (int)(p - text);
+    switch (directive->kind) {
+        case 's':
+        case 'f':
+        case 'd':
+            return 1;
+        case '%':
+            return directive->length == 2;     // Só "%%"
+        default:
+            return 0;
+    }
+}
+
+// Confere o formato inteiro contra os argumentos, sem escrever nada
+static int check_format(const char* text, const char* end, const Value* args, int arg_count,
+                        char* error, int error_size) {
+    int used = 0;
+
+    for (const char* p = text; p < end; p++) {
+        if (*p != '%') continue;
+
+        Directive directive;
+        if (!parse_directive(p, end, &directive)) {
+            int shown = 1;
+            while (shown < 8 && p + shown < end && p[shown] != ' ' && p[shown] != '\n') shown++;
+            if (current_lang == LANG_PT) {
+                snprintf(error, error_size, "printf: diretiva inválida '%.*s'", shown, p);
+            } else {
+                snprintf(error, error_size, "printf: invalid directive '%.*s'", shown, p);
+            }
+            return 0;
+        }
+        p += directive.length - 1;
+        if (directive.kind == '%') continue;
+
+        if (used == arg_count) {
+            if (current_lang == LANG_PT) {
+                snprintf(error, error_size, "printf: o formato pede mais de %d argumento%s",
+                         arg_count, arg_count == 1 ? "" : "s");
+            } else {
+                snprintf(error, error_size, "printf: the format needs more than %d argument%s",
+                         arg_count, arg_count == 1 ? "" : "s");
+            }
+            return 0;
+        }
+        if (directive.kind != 's' && args[used].type != VAL_NUMBER) {
+            if (current_lang == LANG_PT) {
+                snprintf(error, error_size, "printf: %%%c requer número (argumento %d)",
+                         directive.kind, used + 2);
+            } else {
+                snprintf(error, error_size, "printf: %%%c requires a number (argument %d)",
+                         directive.kind, used + 2);
+            }
+            return 0;
+        }
+        used++;
+    }
+
+    if (used < arg_count) {
+        if (current_lang == LANG_PT) {
+            snprintf(error, error_size, "printf: %d argumento%s sem diretiva no formato",
+                     arg_count - used, arg_count - used == 1 ? "" : "s");
+        } else {
+            snprintf(error, error_size, "printf: %d argument%s without a directive in the format",
+                     arg_count - used, arg_count - used == 1 ? "" : "s");
+        }
+        return 0;
+    }
+    return 1;
+}
+
+int format_print(Value format, const Value* args, int arg_count,
+                 int decimal_places, char* error, int error_size) {
+    const char* text = value_string(&format);
+    const char* end = text + value_length(&format);
+
+    if (!check_format(text, end, args, arg_count, error, error_size)) return 0;
+
+    const char* run = text;         // Início do trecho literal pendente
+    const char* p = text;
+    while (p < end) {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+        output_write(run, (size_t)(p - run));
+
+        Directive directive;
+        parse_directive(p, end, &directive);
+        p += directive.length;
+        run = p;
+
+        if (directive.kind == '%') {
+            output_char('%');
+            continue;
+        }
+
+        int places = directive.places >= 0 ? directive.places : decimal_places;
+        if (directive.kind == 'd') places = 0;
+        print_value_aligned(*args++, places, directive.width, directive.alignment);
+    }
+    output_write(run, (size_t)(end - run));
+    return 1;
+}
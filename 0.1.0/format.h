@@ -0,0 +1,36 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include "value.h"
+
+/********************************************************************
+PRINTF - RUDIS
+
+printf(formato, v1, v2, ...) escreve direto no buffer de saída
+(output.h): o texto do formato e cada valor já alinhado, sem montar
+strings intermediárias nem concatenar. Uma linha de tabela como
+    printf("%-20s%^10d%15.2f\n", produto, qtd, preco)
+não aloca nada.
+
+Diretivas: %[alinhamento][largura][.casas]tipo
+- alinhamento: '-' à esquerda, '^' ao centro; sem nada, à direita
+  (como no printf do C)
+- largura: colunas na tela (acentos e códigos ANSI contam certo,
+  ver width.h); valores maiores não são cortados
+- tipo:
+    s  qualquer valor (números com as casas de setdec ou .casas)
+    f  número com as casas de setdec ou .casas
+    d  número arredondado, sem casas
+    %  o próprio '%' (%%)
+Não há quebra de linha automática: use "\n" no formato.
+
+O formato é conferido antes de escrever qualquer coisa, então um erro
+(diretiva desconhecida, argumentos a menos ou a mais, texto em %f)
+não deixa uma linha pela metade na saída.
+********************************************************************/
+
+// Retorna 0 e escreve a mensagem em error em caso de erro
+int format_print(Value format, const Value* args, int arg_count,
+                 int decimal_places, char* error, int error_size);
+
+#endif // FORMAT_H
@@ -103,23 +103,18 @@ double math_mean(double* values, int count) {
 double math_median(double* values, int count) {
     VALIDATE_COUNT(count);
     
-    // Ordena os valores
-    double* sorted = (double*)(A89ALLOC(count * sizeof(double)));
-    for (int i = 0; i < count; i++) {
-        sorted[i] = values[i];
-    }
-    qsort(sorted, count, sizeof(double), compare_doubles);
+    // Ordena os valores no próprio vetor (ver functions.h)
+    qsort(values, count, sizeof(double), compare_doubles);
     
     double median;
     if (count % 2 == 0) {
         // Número par de elementos - média dos dois do meio
-        median = (sorted[count/2 - 1] + sorted[count/2]) / 2.0;
+        median = (values[count/2 - 1] + values[count/2]) / 2.0;
     } else {
         // Número ímpar - elemento do meio
-        median = sorted[count/2];
+        median = values[count/2];
     }
     
-    a89free(sorted);
     return median;
 }
 
@@ -146,22 +141,19 @@ double math_variance(double* values, int count) {
 double math_mode(double* values, int count) {
     VALIDATE_COUNT(count);
     
-    double* sorted = (double*)(A89ALLOC(count * sizeof(double)));
-    for (int i = 0; i < count; i++) {
-        sorted[i] = values[i];
-    }
-    qsort(sorted, count, sizeof(double), compare_doubles);
+    // Ordena os valores no próprio vetor (ver functions.h)
+    qsort(values, count, sizeof(double), compare_doubles);
     
-    double mode = sorted[0];
+    double mode = values[0];
     int max_count = 1, current_count = 1;
     
     for (int i = 1; i < count; i++) {
-        if (sorted[i] == sorted[i-1]) {
+        if (values[i] == values[i-1]) {
             current_count++;
         } else {
             if (current_count > max_count) {
                 max_count = current_count;
-                mode = sorted[i-1];
+                mode = values[i-1];
             }
             current_count = 1;
         }
@@ -169,11 +161,9 @@ double math_mode(double* values, int count) {
     
     // Verifica o último grupo
     if (current_count > max_count) {
-        mode = sorted[count-1];
+        mode = values[count-1];
     }
     
-    a89free(sorted);
-    
     // Se todos os elementos aparecem apenas uma vez, retorna NAN
     return (max_count > 1) ? mode : NAN;
 }
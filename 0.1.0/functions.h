@@ -45,7 +45,7 @@ double math_tan(double x);
 // Média aritmética
 double math_mean(double* values, int count);
 
-// Mediana
+// Mediana (ordena values no próprio vetor)
 double math_median(double* values, int count);
 
 // Desvio padrão
@@ -54,7 +54,7 @@ double math_std(double* values, int count);
 // Variância
 double math_variance(double* values, int count);
 
-// Moda
+// Moda (ordena values no próprio vetor)
 double math_mode(double* values, int count);
 
 // Soma
@@ -103,4 +103,4 @@ double math_compound_interest(double principal, double rate, double time);
 // Montante Juros Compostos
 double math_compound_amount(double principal, double rate, double time);
 
-#endif // FUNCTIONS_H
\ No newline at end of file
+#endif // FUNCTIONS_H
\ No newline at end of file
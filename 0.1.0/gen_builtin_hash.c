@@ -0,0 +1,52 @@
+/*
+ * GERADOR DO HASH PERFEITO DAS FUNÇÕES - RUDIS
+ *
+ * Procura uma semente para builtin_hash() em que todos os nomes de
+ * builtin_table caiam em posições distintas de uma tabela de 256
+ * posições, e imprime BUILTIN_HASH_SEED (para builtins.h) e
+ * builtin_slots (para builtins.c) prontos para colar.
+ *
+ * Rode sempre que uma função for adicionada ou renomeada.
+ * Para compilar, troque main.c por gen_builtin_hash.c em sources.txt.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "builtins.h"
+
+#define SLOT_COUNT 256
+#define MAX_SEEDS 10000000u
+
+int main() {
+    unsigned char slots[SLOT_COUNT];
+
+    for (unsigned int seed = 0; seed < MAX_SEEDS; seed++) {
+        int ok = 1;
+        memset(slots, 0, sizeof(slots));
+
+        for (int id = 0; id < BUILTIN_COUNT && ok; id++) {
+            const char* name = builtin_table[id].name;
+            unsigned int slot = builtin_hash(name, (int)strlen(name), seed) % SLOT_COUNT;
+            if (slots[slot] != 0) {
+                ok = 0;
+            } else {
+                slots[slot] = (unsigned char)(id + 1);
+            }
+        }
+
+        if (!ok) continue;
+
+        printf("#define BUILTIN_HASH_SEED %uu\n\n", seed);
+        printf("static const unsigned char builtin_slots[BUILTIN_SLOT_MASK + 1] = {\n");
+        for (int i = 0; i < SLOT_COUNT; i++) {
+            if (i % 16 == 0) printf("    ");
+            printf("%2d,", slots[i]);
+            printf(i % 16 == 15 ? "\n" : " ");
+        }
+        printf("};\n");
+        return 0;
+    }
+
+    fprintf(stderr, "Nenhuma semente encontrada em %u tentativas\n", MAX_SEEDS);
+    return 1;
+}
@@ -573,6 +573,7 @@ void print_general_help() {
         printf("  clear                   - Limpa a tela\n");
         printf("  vars                    - Lista variáveis definidas\n");
         printf("  reset                   - Remove todas as variáveis\n");
+        printf("  memprof                 - Perfil de alocações (iniciar com --memprof)\n");
     } else {
         printf("  help                    - Shows this general help\n");
         printf("  help <function>         - Specific help for a function\n");
@@ -582,6 +583,7 @@ void print_general_help() {
         printf("  clear                   - Clears screen\n");
         printf("  vars                    - Lists defined variables\n");
         printf("  reset                   - Removes all variables\n");
+        printf("  memprof                 - Allocation profile (start with --memprof)\n");
     }
     
     printf("\n" BOLD "%s\n" RESET, get_help_categories_title());
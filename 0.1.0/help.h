@@ -9,4 +9,4 @@ void print_function_help(const char* function_name);
 void print_help_page(int page);
 int get_total_help_pages(void);
 
-#endif // HELP_H
\ No newline at end of file
+#endif // HELP_H
\ No newline at end of file
@@ -67,6 +67,12 @@ const char* get_error_invalid_number() {
         : "Error: invalid number";
 }
 
+const char* get_error_number_too_large() {
+    return (current_lang == LANG_PT)
+        ? "Número muito grande: %s (máximo 64 bits)"
+        : "Number too large: %s (maximum 64 bits)";
+}
+
 const char* get_error_hex_invalid() {
     return (current_lang == LANG_PT)
         ? "Número hexadecimal inválido: 0x%s (sem dígitos após 0x)"
@@ -109,10 +115,10 @@ const char* get_error_unfinished_string() {
         : "Unfinished string: %s";
 }
 
-const char* get_error_string_too_long() {
+const char* get_error_identifier_too_long() {
     return (current_lang == LANG_PT) 
-        ? "String muito longa (máximo %d caracteres)"
-        : "String too long (maximum %d characters)";
+        ? "Identificador muito longo (máximo %d caracteres)"
+        : "Identifier too long (maximum %d characters)";
 }
 
 //===================================================================
@@ -142,12 +148,6 @@ const char* get_error_expected_rparen_after_args() {
         : "Expected ')' after function arguments";
 }
 
-const char* get_error_max_args_exceeded() {
-    return (current_lang == LANG_PT)
-        ? "Numero máximo de argumentos excedido"
-        : "Maximum number of arguments exceeded";
-}
-
 const char* get_error_invalid_expression() {
     return (current_lang == LANG_PT)
         ? "Expressao inválida"
@@ -32,6 +32,7 @@ void set_language(Language lang);
 // MENSAGENS DE ERRO DO LEXER
 //===================================================================
 const char* get_error_invalid_number(void);
+const char* get_error_number_too_large(void);
 const char* get_error_hex_invalid(void);
 const char* get_error_hex_chars(void);
 const char* get_error_binary_invalid(void);
@@ -39,7 +40,7 @@ const char* get_error_binary_chars(void);
 const char* get_error_identifier(void);
 const char* get_error_unknown_char(void);
 const char* get_error_unfinished_string(void);
-const char* get_error_string_too_long(void);
+const char* get_error_identifier_too_long(void);
 
 //===================================================================
 // MENSAGENS DE ERRO DO PARSER
@@ -48,7 +49,6 @@ const char* get_error_unexpected_token(void);
 const char* get_error_expected_rparen(void);
 const char* get_error_expected_lparen_after_func(void);
 const char* get_error_expected_rparen_after_args(void) ;
-const char* get_error_max_args_exceeded(void);
 const char* get_error_invalid_expression(void);
 const char* get_error_incomplete_expression(void);
 const char* get_error_syntax(void);
@@ -71,4 +71,4 @@ const char* get_text_language_changed_pt(void);
 const char* get_text_language_changed_en(void);
 const char* get_text_syntax_error(void);
 const char* get_text_reset_success(void);
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
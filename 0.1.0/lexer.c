@@ -1,19 +1,158 @@
+#include <stdint.h>
+
 #include "lexer.h"
 #include "lang.h"  
+#include "builtins.h"
+#include "number.h"
+
+/*
+ * CLASSES DE CARACTERES
+ *
+ * Uma consulta em tabela por caractere no lugar de isspace/isdigit/
+ * isalpha, que dependem do locale e custam uma chamada cada. Bytes
+ * acima de 127 (UTF-8) não pertencem a nenhuma classe, como no locale
+ * "C". '\n' não é CC_SPACE: ele encerra a instrução.
+ */
+#define CC_SPACE       0x01    // ' ', \t, \v, \f, \r
+#define CC_DIGIT       0x02    // 0-9
+#define CC_XDIGIT      0x04    // 0-9, a-f, A-F
+#define CC_ALPHA       0x08    // a-z, A-Z
+#define CC_IDENT       0x10    // Letras, dígitos e _
+#define CC_IDENT_START 0x20    // Letras e _
+#define CC_BINARY      0x40    // 0 e 1
+
+#define S_ CC_SPACE
+#define B_ (CC_DIGIT | CC_XDIGIT | CC_IDENT | CC_BINARY)
+#define D_ (CC_DIGIT | CC_XDIGIT | CC_IDENT)
+#define X_ (CC_ALPHA | CC_XDIGIT | CC_IDENT | CC_IDENT_START)
+#define A_ (CC_ALPHA | CC_IDENT | CC_IDENT_START)
+#define U_ (CC_IDENT | CC_IDENT_START)
+
+static const unsigned char char_class[256] = {
+//   0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F
+     0,  0,  0,  0,  0,  0,  0,  0,  0, S_,  0, S_, S_, S_,  0,  0,  // 0x00
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 0x10
+    S_,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  // 0x20  ! " # ...
+    B_, B_, D_, D_, D_, D_, D_, D_, D_, D_,  0,  0,  0,  0,  0,  0,  // 0x30  0-9
+     0, X_, X_, X_, X_, X_, X_, A_, A_, A_, A_, A_, A_, A_, A_, A_,  // 0x40  A-O
+    A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_,  0,  0,  0,  0, U_,  // 0x50  P-Z _
+     0, X_, X_, X_, X_, X_, X_, A_, A_, A_, A_, A_, A_, A_, A_, A_,  // 0x60  a-o
+    A_, A_, A_, A_, A_, A_, A_, A_, A_, A_, A_,  0,  0,  0,  0,  0,  // 0x70  p-z
+    // 0x80-0xFF: nenhuma classe
+};
+
+#undef S_
+#undef B_
+#undef D_
+#undef X_
+#undef A_
+#undef U_
+
+#define CHAR_IS(c, cls) (char_class[(unsigned char)(c)] & (cls))
 
 void lexer_init_token(Token* token) {
     if (token == NULL) return;    
     token->type = TOKEN_UNKNOWN;
     token->value = 0.0;
-    token->text[0] = '\0';
+    token->integer = 0;
+    token->is_integer = 0;
     token->operator = '\0';  
+    token->position = -1;
+    token->length = 0;
+    token->builtin_id = -1;
+}
+
+// Copia input[start, end) para buf (truncando em size - 1 bytes)
+static void lexer_copy_slice(const Lexer* lexer, int start, int end, char* buf, size_t size) {
+    size_t length = (end > start) ? (size_t)(end - start) : 0;
+    if (size == 0) return;
+    if (length > size - 1) length = size - 1;
+    memcpy(buf, lexer->input + start, length);
+    buf[length] = '\0';
+}
+
+char* token_copy_text(const Lexer* lexer, const Token* token, char* buf, size_t size) {
+    lexer_copy_slice(lexer, token->position, token->position + token->length, buf, size);
+    return buf;
+}
+
+// Traduz a sequência de escape \c; devolve 0 se ela não é conhecida
+static char lexer_escape_char(char c) {
+    switch (c) {
+        case 'n':  return '\n';
+        case 't':  return '\t';
+        case 'r':  return '\r';
+        case '"':  return '"';
+        case '\\': return '\\';
+        default:   return '\0';
+    }
+}
+
+/*
+ * VALOR DE UM TOKEN_STRING
+ *
+ * Duas passadas sobre o trecho entre as aspas: a primeira mede o
+ * tamanho final, a segunda escreve direto no buffer do Value. Escapes
+ * desconhecidos ficam como estão (barra invertida + caractere).
+ */
+Value lexer_string_value(const Lexer* lexer, const Token* token) {
+    const char* begin = lexer->input + token->position + 1;                // Depois da aspas inicial
+    const char* end = lexer->input + token->position + token->length - 1;  // Aspas final
+    int length = 0;
+
+    for (const char* p = begin; p < end; p++) {
+        if (*p == '\\' && p + 1 < end) {
+            p++;
+            length += lexer_escape_char(*p) ? 1 : 2;
+        } else {
+            length++;
+        }
+    }
+
+    Value value;
+    char* out = create_string_buffer(&value, length);
+    if (value_length(&value) != length) return value;  // Sem memória
+
+    for (const char* p = begin; p < end; p++) {
+        if (*p == '\\' && p + 1 < end) {
+            p++;
+            char escaped = lexer_escape_char(*p);
+            if (escaped) {
+                *out++ = escaped;
+            } else {
+                *out++ = '\\';
+                *out++ = *p;
+            }
+        } else {
+            *out++ = *p;
+        }
+    }
+    return value;
 }
 
 void lexer_init(Lexer* lexer, const char* input) {
+    lexer_init_buffer(lexer, input, (int)strlen(input));
+}
+
+void lexer_init_buffer(Lexer* lexer, const char* input, int input_size) {
     lexer->input = input;
-    lexer->input_size = (int)strlen(input);
-    lexer->position = 0;
-    lexer->current_char = input[0];
+    lexer->input_size = input_size;
+    lexer_seek(lexer, 0);
+}
+
+// Move o cursor sem mexer no estado da instrução
+static void lexer_jump(Lexer* lexer, int position) {
+    if (position > lexer->input_size) position = lexer->input_size;
+    lexer->position = position;
+    lexer->current_char = position < lexer->input_size ? lexer->input[position] : '\0';
+}
+
+void lexer_seek(Lexer* lexer, int position) {
+    lexer_jump(lexer, position);
+    lexer->token_start = lexer->position;
+    lexer->paren_depth = 0;
+    lexer->last_type = TOKEN_NEWLINE;
+    lexer->last_operator = '\0';
 }
 
 void lexer_advance(Lexer* lexer) {
@@ -26,9 +165,7 @@ void lexer_advance(Lexer* lexer) {
 }
 
 void lexer_skip_whitespace(Lexer* lexer) {
-    while (lexer->current_char != '\0' &&
-           isspace(lexer->current_char) && 
-           lexer->current_char != '\n') {
+    while (CHAR_IS(lexer->current_char, CC_SPACE)) {
         lexer_advance(lexer);
     }
 }
@@ -54,7 +191,7 @@ int lexer_peek_in(Lexer* lexer, const char* options) {
 }
 
 int is_valid_identifier_char(char c) {
-    return isalnum(c) || c == '_';
+    return CHAR_IS(c, CC_IDENT) != 0;
 }
 
 void lexer_skip_python_comment(Lexer* lexer) {
@@ -62,9 +199,7 @@ void lexer_skip_python_comment(Lexer* lexer) {
            lexer->current_char != '\n') {
         lexer_advance(lexer);
     }
-    if (lexer->current_char == '\n') {
-        lexer_advance(lexer);
-    }
+    // O '\n' fica para o scanner: ele encerra a instrução
 }
 
 void lexer_skip_cpp_comment(Lexer* lexer) {
@@ -72,9 +207,7 @@ void lexer_skip_cpp_comment(Lexer* lexer) {
            lexer->current_char != '\n') {
         lexer_advance(lexer);
     }
-    if (lexer->current_char == '\n') {
-        lexer_advance(lexer);
-    }
+    // O '\n' fica para o scanner: ele encerra a instrução
 }
 
 void lexer_skip_c_comment(Lexer* lexer) {
@@ -93,83 +226,179 @@ void lexer_skip_c_comment(Lexer* lexer) {
 
 /*
  * CONVERTE UMA STRING PARA DOUBLE
- * 
+ *
  * A string a ser convertida já deve ter sido verificada e
  * seu formato deve representar um double.
- * Exemplo: 123.45
+ * Exemplos: 123.45, 0.1, 6.02e23, 1e-9
+ *
+ * Os dígitos são acumulados em um inteiro de 64 bits (até 19 dígitos
+ * significativos) junto com o expoente decimal. Quando a mantissa cabe
+ * em 53 bits e 10^|expoente| é exato em double (até 10^22), uma única
+ * multiplicação ou divisão IEEE já dá o resultado corretamente
+ * arredondado (caminho rápido de Clinger), que cobre quase todos os
+ * literais de scripts e arquivos de dados. Os demais casos (mais de 19
+ * dígitos, expoentes grandes) vão para strtod(), que arredonda
+ * corretamente no locale "C" usado pelo Rudis.
  */
-double lexer_str_to_double(const char* str){
-    double value = 0.0;           
-    double decimal_place = 0.1;   
+#define FAST_PATH_MAX_MANTISSA 9007199254740992ull    // 2^53
+#define FAST_PATH_MAX_EXPONENT 22
+#define MAX_MANTISSA_DIGITS 19
+
+static const double exact_powers_of_ten[FAST_PATH_MAX_EXPONENT + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Verifica se 'e'/'E' em str inicia um expoente (e5, e+5, e-5)
+static int is_exponent_start(const char* str) {
+    if (*str != 'e' && *str != 'E') return 0;
+    str++;
+    if (*str == '+' || *str == '-') str++;
+    return CHAR_IS(*str, CC_DIGIT) != 0;
+}
 
-    while (isdigit(*str) && *str) {
-        int digit = *str - '0'; 
-        value = value * 10 + digit;
+// Converte e devolve em *end o primeiro caractere depois do número.
+// Um '.' sem dígitos depois dele não faz parte do número. Se o literal
+// for só dígitos e couber em int64, *integer recebe o valor exato;
+// senão -1 (literais nunca são negativos).
+static double lexer_parse_decimal(const char* str, const char** end, int64_t* integer) {
+    const char* begin = str;
+    uint64_t mantissa = 0;
+    int digits = 0;           // Dígitos significativos em mantissa
+    int exponent = 0;         // valor = mantissa * 10^exponent
+    int truncated = 0;        // Sobraram dígitos fora da mantissa
+    int plain_digits = 1;     // Sem ponto e sem expoente
+
+    while (*str == '0') str++;
+
+    while (CHAR_IS(*str, CC_DIGIT)) {
+        if (digits < MAX_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + (uint64_t)(*str - '0');
+            digits++;
+        } else {
+            exponent++;
+            truncated = 1;
+        }
         str++;
     }
 
-    if (*str == '.') {
+    if (*str == '.' && CHAR_IS(str[1], CC_DIGIT)) {
         str++;
+        plain_digits = 0;
 
-        while (isdigit(*str) && 
-               *str != '\0') {         
-            int digit = *str - '0';
-            value += digit * decimal_place;
-            decimal_place *= 0.1;
+        // Zeros logo após o ponto (0.000123) só mudam o expoente
+        if (digits == 0) {
+            while (*str == '0') {
+                exponent--;
+                str++;
+            }
+        }
+        while (CHAR_IS(*str, CC_DIGIT)) {
+            if (digits < MAX_MANTISSA_DIGITS) {
+                mantissa = mantissa * 10 + (uint64_t)(*str - '0');
+                digits++;
+                exponent--;
+            } else {
+                truncated = 1;
+            }
             str++;
         }
     }
 
-    return value;
+    if (is_exponent_start(str)) {
+        str++;
+        plain_digits = 0;
+        int sign = 1;
+        if (*str == '+' || *str == '-') {
+            if (*str == '-') sign = -1;
+            str++;
+        }
+        int value = 0;
+        while (CHAR_IS(*str, CC_DIGIT)) {
+            if (value < 100000) value = value * 10 + (*str - '0');  // Evita overflow
+            str++;
+        }
+        exponent += sign * value;
+    }
+    *end = str;
+
+    *integer = (plain_digits && !truncated && mantissa <= (uint64_t)INT64_MAX)
+             ? (int64_t)mantissa : -1;
+
+    if (mantissa == 0) return 0.0;
+
+    if (!truncated && mantissa <= FAST_PATH_MAX_MANTISSA) {
+        double value = (double)mantissa;
+        if (exponent >= 0 && exponent <= FAST_PATH_MAX_EXPONENT) {
+            return value * exact_powers_of_ten[exponent];
+        }
+        if (exponent < 0 && exponent >= -FAST_PATH_MAX_EXPONENT) {
+            return value / exact_powers_of_ten[-exponent];
+        }
+        // 12e30: passa parte do expoente para a mantissa enquanto ela
+        // continuar exata, e aplica 10^22 no fim
+        if (exponent > FAST_PATH_MAX_EXPONENT) {
+            while (exponent > FAST_PATH_MAX_EXPONENT && mantissa <= FAST_PATH_MAX_MANTISSA / 10) {
+                mantissa *= 10;
+                exponent--;
+            }
+            if (exponent <= FAST_PATH_MAX_EXPONENT) {
+                return (double)mantissa * exact_powers_of_ten[exponent];
+            }
+        }
+    }
+
+    return strtod(begin, NULL);
+}
+
+double lexer_str_to_double(const char* str) {
+    const char* end;
+    int64_t integer;
+    return lexer_parse_decimal(str, &end, &integer);
+}
+
+// Valor de um dígito hexadecimal (o caractere já foi validado)
+static int hex_digit_value(char c) {
+    if (CHAR_IS(c, CC_DIGIT)) return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return c - 'A' + 10;
 }
 
 /*
- * CONVERTE STRING HEXADECIMAL PARA DOUBLE
+ * CONVERTE STRING HEXADECIMAL PARA UINT64
  *
  * Pré-condição: String contém apenas dígitos hexadecimais (0-9, A-F, a-f)
  * Não inclui o prefixo "0x" - apenas os dígitos
+ *
+ * O valor é acumulado exatamente em 64 bits; set_literal_bits o lê
+ * em complemento de dois. O lexer rejeita literais com mais de 64
+ * bits (LEXER_MAX_HEX_DIGITS).
  */
-double lexer_hex_str_to_double(const char* str) {
-    double value = 0.0;
-    
-    while (*str) {
-        int digit;
-        
-        if (isdigit(*str)) {
-            digit = *str - '0';
-        } else if (*str >= 'A' && *str <= 'F') {
-            digit = *str - 'A' + 10;
-        } else if (*str >= 'a' && *str <= 'f') {
-            digit = *str - 'a' + 10;
-        } else {
-            break;
-        }
-        
-        value = value * 16 + digit;
+static uint64_t hex_str_to_uint64(const char* str) {
+    uint64_t value = 0;
+
+    while (CHAR_IS(*str, CC_XDIGIT)) {
+        value = (value << 4) | (uint64_t)hex_digit_value(*str);
         str++;
     }
-    
+
     return value;
 }
 
 /**
- * Converte string binária para double
+ * Converte string binária para uint64
  * Pré-condição: String contém apenas dígitos binários (0-1)
  * Não inclui o prefixo "0b" - apenas os dígitos
+ * Acumulado exatamente em 64 bits, como o hexadecimal.
  */
-double lexer_binary_str_to_double(const char* str) {
-    double value = 0.0;
-    
-    while (*str) {
-        if (*str == '0' || *str == '1') {
-            int digit = *str - '0';
-            value = value * 2 + digit;
-        } else {
-            break;
-        }
+static uint64_t binary_str_to_uint64(const char* str) {
+    uint64_t value = 0;
+
+    while (CHAR_IS(*str, CC_BINARY)) {
+        value = (value << 1) | (uint64_t)(*str - '0');
         str++;
     }
-    
+
     return value;
 }
 
@@ -179,48 +408,64 @@ double lexer_binary_str_to_double(const char* str) {
  * O número pode ser:
  * - Inteiro: 123
  * - Decimal: 123.45
- * - Hexadecimal: 0xFF, 0x1A, 0X2B
- * 
+ * - Com expoente: 1e-9, 6.02E+23 (formato que number_to_string_value
+ *   usa para números muito grandes ou muito pequenos)
+ *
+ * O número é lido e convertido em uma só passada direto da entrada,
+ * sem cópia intermediária.
  * Retorna um token do tipo TOKEN_NUMBER com o valor numérico.
  */
 Token lexer_read_number(Lexer* lexer) {
     Token token;
     lexer_init_token(&token);
-    char buffer[64];
-    int i = 0;
+    const char* end;
 
-    while(isdigit(lexer->current_char) &&
-                  lexer->current_char != '\0' &&
-                  i < 63){
-        buffer[i++] = lexer->current_char;
-        lexer_advance(lexer);
-    }
+    // "2e" sem dígitos não é expoente: fica o número 2 e o identificador e
+    int64_t integer;
+    token.value = lexer_parse_decimal(lexer->input + lexer->position, &end, &integer);
+    lexer_jump(lexer, (int)(end - lexer->input));
 
-    if(lexer->current_char == '.'){
-        buffer[i++] = lexer->current_char;
+    // "1." ou "1.e5": o ponto precisa de dígitos depois dele
+    if (lexer->current_char == '.') {
         lexer_advance(lexer);
-        if(!isdigit(lexer->current_char)){
-            buffer[i] = '\0';
-            token.type = TOKEN_ERROR;
-            strncpy(token.text, get_error_invalid_number(), sizeof(token.text) - 1);
-            token.text[sizeof(token.text) - 1] = '\0';
-            return token;
-        }
-        while(isdigit(lexer->current_char) &&
-                      lexer->current_char != '\0' &&
-                      i < 63){
-            buffer[i++] = lexer->current_char;
-            lexer_advance(lexer);
-        } 
-    } 
+        return create_error_token(lexer, get_error_invalid_number());
+    }
 
-    buffer[i] = '\0';
     token.type = TOKEN_NUMBER;
-    token.value = lexer_str_to_double(buffer);
-    strcpy(token.text, buffer);
+    if (integer >= 0) {
+        token.integer = integer;
+        token.is_integer = 1;
+    }
     return token;
 }
 
+// Literais hexadecimais e binários são inteiros de até 64 bits
+#define LEXER_MAX_HEX_DIGITS 16
+#define LEXER_MAX_BINARY_DIGITS 64
+
+// Os bits do literal em complemento de dois: 0x8000000000000000 é
+// INT64_MIN, como 1 << 63, e 0xFFFFFFFFFFFFFFFF é -1, como ~0
+static void set_literal_bits(Token* token, uint64_t bits) {
+    token->type = TOKEN_NUMBER;
+    token->integer = number_from_bits(bits);
+    token->value = (double)token->integer;
+    token->is_integer = 1;
+}
+
+// Dígitos significativos (sem zeros à esquerda) de input[start, position)
+static int lexer_fits_64_bits(const Lexer* lexer, int start, int max_digits) {
+    while (start < lexer->position && lexer->input[start] == '0') start++;
+    return lexer->position - start <= max_digits;
+}
+
+static Token lexer_number_too_large(Lexer* lexer) {
+    char literal[64];
+    char error_message[STR_SIZE];
+    lexer_copy_slice(lexer, lexer->token_start, lexer->position, literal, sizeof(literal));
+    snprintf(error_message, sizeof(error_message), get_error_number_too_large(), literal);
+    return create_error_token(lexer, error_message);
+}
+
 /*
  * LÊ UM NÚMERO HEXADECIMAL
  *
@@ -231,48 +476,35 @@ Token lexer_read_number(Lexer* lexer) {
 Token lexer_read_hexadecimal(Lexer *lexer) {
     Token token;
     lexer_init_token(&token);
-    char buffer[64];
-    int i = 0;
-    
-    int has_hex_digits = 0;
-    while (i < 63 && lexer->current_char != '\0' && 
-           isxdigit(lexer->current_char)) {
-        buffer[i++] = lexer->current_char;
+    char digits[64];
+    int start = lexer->position;
+
+    while (CHAR_IS(lexer->current_char, CC_XDIGIT)) {
         lexer_advance(lexer);
-        has_hex_digits = 1;
     }
-    
-    if (!has_hex_digits) {
-        buffer[i] = '\0';
+
+    if (lexer->position == start) {
         char error_message[STR_SIZE];
-        snprintf(error_message, sizeof(error_message), get_error_hex_invalid(), buffer);
-        return create_error_token(error_message);
+        snprintf(error_message, sizeof(error_message), get_error_hex_invalid(), "");
+        return create_error_token(lexer, error_message);
     }
-    
-    if (i < 63 && lexer->current_char != '\0' && 
-        (isalpha(lexer->current_char) || lexer->current_char == '_')) {
-        
-        while (i < 63 && lexer->current_char != '\0' && 
-               (isalnum(lexer->current_char) || lexer->current_char == '_')) {
-            buffer[i++] = lexer->current_char;
+
+    if (CHAR_IS(lexer->current_char, CC_IDENT_START)) {
+        while (CHAR_IS(lexer->current_char, CC_IDENT)) {
             lexer_advance(lexer);
         }
-        buffer[i] = '\0';
-        
+        lexer_copy_slice(lexer, start, lexer->position, digits, sizeof(digits));
+
         char error_message[STR_SIZE];
-        snprintf(error_message, sizeof(error_message), get_error_hex_chars(), buffer);
-        return create_error_token(error_message);
+        snprintf(error_message, sizeof(error_message), get_error_hex_chars(), digits);
+        return create_error_token(lexer, error_message);
     }
-    
-    buffer[i] = '\0';
-    token.type = TOKEN_NUMBER;
-    token.value = lexer_hex_str_to_double(buffer);
-    
-    char display_buffer[66];
-    snprintf(display_buffer, sizeof(display_buffer), "0x%s", buffer);
-    strncpy(token.text, display_buffer, sizeof(token.text) - 1);
-    token.text[sizeof(token.text) - 1] = '\0';
-    
+
+    if (!lexer_fits_64_bits(lexer, start, LEXER_MAX_HEX_DIGITS)) {
+        return lexer_number_too_large(lexer);
+    }
+
+    set_literal_bits(&token, hex_str_to_uint64(lexer->input + start));
     return token;
 }
 
@@ -285,224 +517,135 @@ Token lexer_read_hexadecimal(Lexer *lexer) {
 Token lexer_read_binary(Lexer *lexer) {
     Token token;
     lexer_init_token(&token);
-    char buffer[64];
-    int i = 0;
-    
-    int has_binary_digits = 0;
-    while (i < 63 && lexer->current_char != '\0' && 
-           (lexer->current_char == '0' || lexer->current_char == '1')) {
-        buffer[i++] = lexer->current_char;
+    char digits[64];
+    int start = lexer->position;
+
+    while (CHAR_IS(lexer->current_char, CC_BINARY)) {
         lexer_advance(lexer);
-        has_binary_digits = 1;
     }
-    
-    if (!has_binary_digits) {
-        buffer[i] = '\0';
+
+    if (lexer->position == start) {
         char error_message[STR_SIZE];
-        snprintf(error_message, sizeof(error_message), get_error_binary_invalid(), buffer);
-        return create_error_token(error_message);
+        snprintf(error_message, sizeof(error_message), get_error_binary_invalid(), "");
+        return create_error_token(lexer, error_message);
     }
-    
-    if (i < 63 && lexer->current_char != '\0' && 
-        (isdigit(lexer->current_char) || isalpha(lexer->current_char) || 
-         lexer->current_char == '_')) {
-        
-        while (i < 63 && lexer->current_char != '\0' && 
-               (isalnum(lexer->current_char) || lexer->current_char == '_')) {
-            buffer[i++] = lexer->current_char;
+
+    if (CHAR_IS(lexer->current_char, CC_IDENT)) {
+        while (CHAR_IS(lexer->current_char, CC_IDENT)) {
             lexer_advance(lexer);
         }
-        buffer[i] = '\0';
-        
+        lexer_copy_slice(lexer, start, lexer->position, digits, sizeof(digits));
+
         char error_message[STR_SIZE];
-        snprintf(error_message, sizeof(error_message), get_error_binary_chars(), buffer);
-        return create_error_token(error_message);
+        snprintf(error_message, sizeof(error_message), get_error_binary_chars(), digits);
+        return create_error_token(lexer, error_message);
     }
-    
-    buffer[i] = '\0';
-    token.type = TOKEN_NUMBER;
-    token.value = lexer_binary_str_to_double(buffer);
-    
-    char display_buffer[66];
-    snprintf(display_buffer, sizeof(display_buffer), "0b%s", buffer);
-    strncpy(token.text, display_buffer, sizeof(token.text) - 1);
-    token.text[sizeof(token.text) - 1] = '\0';
-    
+
+    if (!lexer_fits_64_bits(lexer, start, LEXER_MAX_BINARY_DIGITS)) {
+        return lexer_number_too_large(lexer);
+    }
+
+    set_literal_bits(&token, binary_str_to_uint64(lexer->input + start));
     return token;
 }
 
 /*
  * LEITURA DE IDENTIFICADORES E FUNÇÕES
- * 
+ *
  * Lê uma sequência de letras que pode ser:
  * - Uma variável: começa com letra ou _, pode ter letras, dígitos e _
  * - Uma função: sqrt, sin, mean, pv, etc.
- * 
+ *
  * Retorna TOKEN_IDENTIFIER para variáveis ou
- * TOKEN_FUNCTION para funções.
+ * TOKEN_FUNCTION para funções. O hash perfeito dos builtins é
+ * calculado enquanto o nome é lido, então reconhecer a função custa
+ * uma consulta em builtin_slots e uma comparação.
  */
 Token lexer_read_identifier(Lexer* lexer) {
     Token token;
     lexer_init_token(&token);
-    char identifier[STR_SIZE];
-    char error_msg[STR_SIZE];
-    int index = 0;
-    
-    while (lexer->current_char != '\0' && 
-           is_valid_identifier_char(lexer->current_char)) {
-        identifier[index++] = lexer->current_char;
+    const char* identifier = lexer->input + lexer->position;
+    int start = lexer->position;
+    unsigned int hash = BUILTIN_HASH_INIT(BUILTIN_HASH_SEED);
+
+    while (CHAR_IS(lexer->current_char, CC_IDENT)) {
+        hash = BUILTIN_HASH_STEP(hash, lexer->current_char);
         lexer_advance(lexer);
     }
-    
-    identifier[index] = '\0';
-    strcpy(token.text, identifier);
-    
-    if (is_function(identifier)) {
+    int length = lexer->position - start;
+
+    // Os nomes de variáveis são guardados em buffers de STR_SIZE
+    if (length >= STR_SIZE) {
+        char error_message[STR_SIZE];
+        snprintf(error_message, sizeof(error_message),
+                 get_error_identifier_too_long(), STR_SIZE - 1);
+        return create_error_token(lexer, error_message);
+    }
+
+    int builtin_id = builtin_lookup_hashed(identifier, length, BUILTIN_HASH_FINISH(hash));
+    if (builtin_id != BUILTIN_NONE) {
         token.type = TOKEN_FUNCTION;
-    } else if (isalpha(identifier[0]) || identifier[0] == '_') {
+        token.builtin_id = builtin_id;
+    } else if (CHAR_IS(identifier[0], CC_IDENT_START)) {
         token.type = TOKEN_IDENTIFIER;
     } else {
+        char name[STR_SIZE];
+        lexer_copy_slice(lexer, start, lexer->position, name, sizeof(name));
+        snprintf(lexer->error_message, sizeof(lexer->error_message),
+                 get_error_identifier(), name);
         token.type = TOKEN_ERROR;
-        sprintf(error_msg, get_error_identifier(), identifier);
-        strcpy(token.text, error_msg);
     }
-    
+
     return token;
 }
 
 /*
  * LEITURA DE STRINGS
- * 
- * Lê uma sequência de caracteres envolvidas em aspas duplas:
- * Tamanho máximo da string 256 caracteres.
- * 
+ *
+ * Lê uma sequência de caracteres envolvidas em aspas duplas. O lexer
+ * só encontra o fim da string (pulando as sequências de escape); o
+ * token aponta para o trecho com as aspas e lexer_string_value()
+ * monta o valor. Não há limite de tamanho.
+ *
  * Retorna TOKEN_STRING
  */
 Token lexer_read_string(Lexer* lexer) {
     Token token;
     lexer_init_token(&token);
-    char string_value[STR_SIZE];
-    char error_msg[STR_SIZE];
-    int index = 0;
-    
+
     char delimiter = lexer->current_char;  // " (aspas duplas)
     lexer_advance(lexer);  // Pula a aspas inicial
-    
-    // Lê o conteúdo da string
-    while (lexer->current_char != '\0' && 
+
+    while (lexer->current_char != '\0' &&
            lexer->current_char != delimiter) {
-        
-        // Trata caracteres de escape
+
         if (lexer->current_char == '\\') {
             lexer_advance(lexer);  // Pula a barra invertida
-            
+
             if (lexer->current_char == '\0') {
-                // Erro: string terminada abruptamente após \
+                // Erro: string terminada logo após a barra invertida
+                snprintf(lexer->error_message, sizeof(lexer->error_message),
+                         get_error_unfinished_string(), "\\");
                 token.type = TOKEN_ERROR;
-                sprintf(error_msg, get_error_unfinished_string(), "\\");
-                strcpy(token.text, error_msg);
                 return token;
             }
-            
-            // Processa sequência de escape
-            switch (lexer->current_char) {
-                case 'n':  string_value[index++] = '\n'; break;
-                case 't':  string_value[index++] = '\t'; break;
-                case 'r':  string_value[index++] = '\r'; break;
-                case '"':  string_value[index++] = '"'; break;
-                case '\\': string_value[index++] = '\\'; break;
-                default:   // Escape desconhecido, mantém como está
-                    string_value[index++] = '\\';
-                    string_value[index++] = lexer->current_char;
-                    break;
-            }
-            lexer_advance(lexer);
-        } else {
-            // Caractere normal
-            string_value[index++] = lexer->current_char;
-            lexer_advance(lexer);
-        }
-        
-        // Verifica overflow do buffer
-        if (index >= 255) {
-            token.type = TOKEN_ERROR;
-            sprintf(error_msg, get_error_string_too_long(), 255);
-            strcpy(token.text, error_msg);
-            return token;
         }
+        lexer_advance(lexer);
     }
-    // Termina a string
-    string_value[index] = '\0';
 
     // Verifica se encontrou a aspas final
     if (lexer->current_char == delimiter) {
         lexer_advance(lexer);  // Pula a aspas final
         token.type = TOKEN_STRING;
-        strcpy(token.text, string_value);
     } else {
         // Erro: string não fechada
         token.type = TOKEN_ERROR;
-        sprintf(token.text, "String não terminada: caractere '%c' esperado", delimiter);
+        snprintf(lexer->error_message, sizeof(lexer->error_message),
+                 "String não terminada: caractere '%c' esperado", delimiter);
     }
-    
-    return token;
-
-}
 
-int is_function(const char* text) {
-    // LISTA DE FUNÇÕES RUDIS
-    const char* functions[] = {
-        // ============ MATEMÁTICAS BÁSICAS ============
-        "sqrt", "sin", "cos", "tan", "log", "ln", "exp", "abs",
-        
-        // ============ ESTATÍSTICAS ============
-        "mean", "median", "std", "sum", "min", "max",
-        "variance", "mode",  
-        
-        // ============ FINANCEIRAS ============
-        "pv", "fv", "pmt", "nper", "rate",
-        "si",           // Simple Interest
-        "fv_si",        // Future Value Simple
-        "ci",           // Compound Interest  
-        "fv_ci",        // Future Value Compound
-        "npv",          // Net Present Value - NOVA
-        "irr",          // Internal Rate of Return - NOVA
-
-        // ============ DE CONFIGURAÇÃO =============================
-        "setdec",       // Ajusta o número de casas decimais
-        "clear",
-        // ============ DE ENTRADA/SAIDA ============================
-        "print",                    // Imprime na tela
-        "left", "center", "right",  // Configura tamaho do campo e alinhamento do texto 
-
-        // ============ CORES E ESTILOS =============================
-        // Cores do texto
-        "black", "red", "green", "yellow", "blue", "magenta", "cyan", "white",
-        "bright_black", "bright_red", "bright_green", "bright_yellow", "bright_blue",
-        "bright_magenta", "bright_cyan", "bright_white",
-        
-        // Cores de fundo
-        "bg_black", "bg_red", "bg_green", "bg_yellow", "bg_blue", "bg_magenta",
-        "bg_cyan", "bg_white", "bg_bright_black", "bg_bright_red", "bg_bright_green",
-        "bg_bright_yellow", "bg_bright_blue", "bg_bright_magenta", "bg_bright_cyan",
-        "bg_bright_white",
-        
-        // Estilos
-        "bold", "dim", "italic", "underline", "blink", "inverse", "hidden", "strikethrough",
+    return token;
 
-        //================ FUNÇÕES DE STRINGS =======================
-        "repeat",
-    };
-    
-    int num_functions = sizeof(functions) / sizeof(functions[0]);
-    
-    for (int i = 0; i < num_functions; i++) {
-        if (strcmp(text, functions[i]) == 0) {
-            return 1;
-        }
-    }
-    
-    return 0;
 }
 
 int is_reserved_word(const char* text) {
@@ -553,14 +696,12 @@ int is_reserved_word(const char* text) {
     return 0;  // Não é palavra reservada
 }
 
-Token lexer_get_next_token(Lexer* lexer) {
-    char error_msg[STR_SIZE];
+static Token lexer_scan_token(Lexer* lexer) {
     Token token;
     lexer_init_token(&token);
     
     while (lexer->current_char != '\0') {
-        if (isspace(lexer->current_char) && 
-            lexer->current_char != '\n') {
+        if (CHAR_IS(lexer->current_char, CC_SPACE)) {
                 lexer_skip_whitespace(lexer);
                 continue;
         }
@@ -585,13 +726,15 @@ Token lexer_get_next_token(Lexer* lexer) {
             }
         }
 
+        lexer->token_start = lexer->position;
+
         // STRINGS
         if (lexer->current_char == '"') {
             return lexer_read_string(lexer);
         }
 
         // NÚMEROS
-        if (isdigit(lexer->current_char)) {
+        if (CHAR_IS(lexer->current_char, CC_DIGIT)) {
             if (lexer->current_char == '0') {
                 // SOLUÇÃO PARA O BUG DE DIVISÃO POR ZERO NO REPL
                 if(lexer_peek_next(lexer) == 0){
@@ -612,7 +755,7 @@ Token lexer_get_next_token(Lexer* lexer) {
         }
         
         // IDENTIFICADORES E FUNÇÕES
-        if (isalpha(lexer->current_char) || lexer->current_char == '_') {
+        if (CHAR_IS(lexer->current_char, CC_IDENT_START)) {
             return lexer_read_identifier(lexer);
         }
         
@@ -625,10 +768,28 @@ Token lexer_get_next_token(Lexer* lexer) {
             case '%':
             case '!':
             case '^':
+            case '&':
+            case '|':
+            case '~':
                 token.type = TOKEN_OPERATOR;
                 token.operator = lexer->current_char;
                 lexer_advance(lexer);
                 return token;
+
+            case '<':
+            case '>':
+                // << e >>: o operador do token é só o primeiro caractere
+                if (lexer_peek_next(lexer) != lexer->current_char) {
+                    snprintf(lexer->error_message, sizeof(lexer->error_message),
+                             get_error_unknown_char(), lexer->current_char);
+                    token.type = TOKEN_ERROR;
+                    return token;
+                }
+                token.type = TOKEN_OPERATOR;
+                token.operator = lexer->current_char;
+                lexer_advance(lexer);
+                lexer_advance(lexer);
+                return token;
                 
             case '(':
                 token.type = TOKEN_LPAREN;
@@ -661,26 +822,65 @@ Token lexer_get_next_token(Lexer* lexer) {
                 return token;
                 
             default:
-                sprintf(error_msg, get_error_unknown_char(), lexer->current_char);
+                snprintf(lexer->error_message, sizeof(lexer->error_message),
+                         get_error_unknown_char(), lexer->current_char);
                 token.type = TOKEN_ERROR;
-                strcpy(token.text, error_msg);
                 return token;             
         }
     }
     
+    lexer->token_start = lexer->position;
     token.type = TOKEN_EOF;
     return token;
 }
 
-Token create_error_token(const char* message) {
+// A quebra de linha só encerra a instrução se ela puder terminar ali
+static int lexer_line_continues(Lexer* lexer) {
+    if (lexer->paren_depth > 0) return 1;
+
+    switch (lexer->last_type) {
+        case TOKEN_OPERATOR:
+            return lexer->last_operator != '!';   // '!' é pós-fixo
+        case TOKEN_ASSIGN:
+        case TOKEN_COMMA:
+        case TOKEN_LPAREN:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+Token lexer_get_next_token(Lexer* lexer) {
+    Token token = lexer_scan_token(lexer);
+    while (token.type == TOKEN_NEWLINE && lexer_line_continues(lexer)) {
+        token = lexer_scan_token(lexer);
+    }
+    token.position = lexer->token_start;
+    token.length = lexer->position - lexer->token_start;
+
+    if (token.type == TOKEN_LPAREN) {
+        lexer->paren_depth++;
+    } else if (token.type == TOKEN_RPAREN && lexer->paren_depth > 0) {
+        lexer->paren_depth--;
+    }
+    lexer->last_type = token.type;
+    lexer->last_operator = token.operator;
+    return token;
+}
+
+Token create_error_token(Lexer* lexer, const char* message) {
     Token token;
     lexer_init_token(&token);
     token.type = TOKEN_ERROR;
-    strcpy(token.text, message);
+    strncpy(lexer->error_message, message, sizeof(lexer->error_message) - 1);
+    lexer->error_message[sizeof(lexer->error_message) - 1] = '\0';
     return token;
 }
 
-void lexer_print_token(Token token) {
+void lexer_print_token(const Lexer* lexer, Token token) {
+    char text[STR_SIZE];
+    token_copy_text(lexer, &token, text, sizeof(text));
+
     const char* type_names[] = {
         "UNKNOWN", "NUMBER", "IDENTIFIER", "OPERATOR", "FUNCTION", 
         "LPAREN", "RPAREN", "COMMA", "ASSIGN","SEMICOLON",
@@ -691,19 +891,19 @@ void lexer_print_token(Token token) {
     
     switch (token.type) {
         case TOKEN_STRING:
-            printf("value: \"%s\"", token.text);
+            printf("value: %s", text);
             break;
 
         case TOKEN_NUMBER:
             printf("value: %g", token.value);
-            if (strlen(token.text) > 0) {
-                printf(" (text: %s)", token.text);
+            if (token.length > 0) {
+                printf(" (text: %s)", text);
             }
             break;
             
         case TOKEN_IDENTIFIER:
         case TOKEN_FUNCTION:
-            printf("text: '%s'", token.text);
+            printf("text: '%s'", text);
             break;
             
         case TOKEN_OPERATOR:
@@ -711,7 +911,7 @@ void lexer_print_token(Token token) {
             break;
             
         case TOKEN_ERROR:
-            printf("error: '%s'", token.text);
+            printf("error: '%s'", lexer->error_message);
             break;
             
         case TOKEN_LPAREN:
@@ -735,7 +935,7 @@ void lexer_print_token(Token token) {
             break;
             
         case TOKEN_COMMENT:
-            printf("comment: '%s'", token.text);
+            printf("comment: '%s'", text);
             break;    
             
         case TOKEN_EOF:
@@ -763,7 +963,7 @@ void lexer_print_all_tokens(const char* input) {
     do {
         token = lexer_get_next_token(&lexer);
         printf("%2d: ", ++token_count);
-        lexer_print_token(token);
+        lexer_print_token(&lexer, token);
         
         if (token.type == TOKEN_ERROR) {
             printf("ERRO ENCONTRADO - parando análise\n");
@@ -773,4 +973,4 @@ void lexer_print_all_tokens(const char* input) {
     } while (token.type != TOKEN_EOF);
     
     printf("=== FIM DA ANÁLISE ===\n\n");
-}
\ No newline at end of file
+}
\ No newline at end of file
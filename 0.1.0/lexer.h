@@ -8,12 +8,13 @@
 #include <math.h>
 
 #include "common.h"
+#include "value.h"
 
 /*
  * TIPOS DE TOKENS - RUDIS
  * 
  * O lexer identifica diferentes tipos de elementos na expressão:
- * - TOKEN_NUMBER: números (inteiros, decimais, hex, bin)
+ * - TOKEN_NUMBER: números (inteiros, decimais, com expoente, hex, bin)
  * - TOKEN_IDENTIFIER: variáveis (começa com letra, pode ter letras, dígitos e _)
  * - TOKEN_OPERATOR: operadores matemáticos (+, -, *, /, %, !, ^)
  * - TOKEN_FUNCTION: funções matemáticas, estatísticas e financeiras
@@ -45,10 +46,20 @@ typedef enum {
     TOKEN_STRING,
 } RTokenType; // Rudis TokenType para não ter conflito com TokenType definido no winnt.h do Windows.
 
+/*
+ * O token não copia o texto: ele é o trecho [position, position + length)
+ * da entrada do lexer, que precisa continuar viva enquanto o token for
+ * usado. token_copy_text() e lexer_string_value() extraem o texto quando
+ * necessário. A mensagem de TOKEN_ERROR fica em lexer->error_message.
+ */
 typedef struct {
-    RTokenType type;
     double value;          // Para números
-    char text[STR_SIZE];// Para identificadores, funções, comentários e strings
+    int64_t integer;       // Para números inteiros (is_integer): o valor exato
+    int is_integer;        // Literal sem ponto nem expoente que cabe em int64
+    RTokenType type;
+    int position;          // Posição do início do token na entrada
+    int length;            // Tamanho do trecho na entrada
+    int builtin_id;        // Para TOKEN_FUNCTION: índice em builtin_table
     char operator;         // Para operadores
 } Token;
 
@@ -61,12 +72,21 @@ void lexer_init_token(Token* token);
  * - input: string de entrada
  * - position: posição atual na string
  * - current_char: caractere atual sendo analisado
+ * - token_start: posição onde começa o token sendo lido
+ * - paren_depth / last_type / last_operator: decidem se uma quebra de
+ *   linha encerra a instrução ou apenas a continua na linha seguinte
+ * - error_message: mensagem do último TOKEN_ERROR
  */
 typedef struct {
     const char* input;
     int input_size;
     int position;
     char current_char;
+    int token_start;       // Início do token sendo lido
+    int paren_depth;       // Parênteses abertos ainda não fechados
+    RTokenType last_type;  // Tipo do último token devolvido
+    char last_operator;    // Operador do último token (se TOKEN_OPERATOR)
+    char error_message[STR_SIZE];  // Mensagem do último TOKEN_ERROR
 } Lexer;
 
 /*
@@ -76,6 +96,12 @@ typedef struct {
 // Inicializa o lexer com uma string de entrada
 void lexer_init(Lexer* lexer, const char* input);
 
+// Inicializa o lexer com um buffer de tamanho conhecido (terminado em '\0')
+void lexer_init_buffer(Lexer* lexer, const char* input, int input_size);
+
+// Reposiciona o lexer no início de uma nova instrução
+void lexer_seek(Lexer* lexer, int position);
+
 // Avança para o próximo caractere
 void lexer_advance(Lexer* lexer);
 
@@ -104,14 +130,9 @@ void lexer_skip_c_comment(Lexer* lexer);
 int is_valid_identifier_char(char c);
 
 // Converte uma string em formato de numero em seu valor double
+// (para no primeiro caractere que não faz parte do número)
 double lexer_str_to_double(const char* str);
 
-// Converte uma string em formato de numero hexadecimal em seu valor double
-double lexer_hex_str_to_double(const char* str);
-
-// Converte uma string em formato de numero binário em seu valor double
-double lexer_binary_str_to_double(const char* str);
-
 // Lê um número hexadecimal
 Token lexer_read_hexadecimal(Lexer* lexer);
 
@@ -127,22 +148,29 @@ Token lexer_read_identifier(Lexer* lexer);
 // Lê uma string
 Token lexer_read_string(Lexer* lexer);
 
-// Obtém o próximo token
+// Obtém o próximo token. Quebras de linha dentro de parênteses ou
+// depois de um operador binário, '=' ou ',' não geram TOKEN_NEWLINE:
+// a instrução continua na linha seguinte.
 Token lexer_get_next_token(Lexer* lexer);
 
-// Verifica se uma string é uma função conhecida da linguagem Rudis
-int is_function(const char* text);
-
 // Verifica se uma string é uma palavra reservada da linguagem Rudis
 int is_reserved_word(const char* text);
 
-// Cria um token de erro com mensagem
-Token create_error_token(const char* message);
+// Cria um token de erro; a mensagem é copiada para lexer->error_message
+Token create_error_token(Lexer* lexer, const char* message);
+
+// Texto do token (identificador, função, número...) em buf, terminado em
+// '\0' e truncado em size - 1 bytes. Devolve buf.
+char* token_copy_text(const Lexer* lexer, const Token* token, char* buf, size_t size);
+
+// Conteúdo de um TOKEN_STRING sem as aspas e com os escapes (\n, \t,
+// \r, \", \\) já traduzidos. O Value pertence ao chamador.
+Value lexer_string_value(const Lexer* lexer, const Token* token);
 
 // Imprime um token para debug (formato legível)
-void lexer_print_token(Token token);
+void lexer_print_token(const Lexer* lexer, Token token);
 
 // Imprime todos os tokens de uma string (para testes)
 void lexer_print_all_tokens(const char* input);
 
-#endif // LEXER_H
\ No newline at end of file
+#endif // LEXER_H
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <ctype.h>
+#include <limits.h>
 
 #include "common.h"
 #include "color.h"
@@ -9,13 +11,20 @@
 #include "help.h"
 #include "lexer.h"
 #include "parser.h"
+#include "arena.h"
 #include "evaluator.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "optimizer.h"
 #include "a89alloc.h"
 #include "functions.h"
+#include "output.h"
 
 //
 
 void process_input(const char* input);
+int process_command(const char* input);
+int run_ast(ASTNode* ast);
 
 // Configuração UTF-8 para Windows
 #ifdef _WIN32
@@ -33,6 +42,26 @@ void setup_utf8() {
 // Estado global do evaluator
 EvaluatorState evaluator_state;
 
+// Arena dos nós da AST, reaproveitada a cada linha do REPL
+Arena parse_arena;
+
+// Bytecode da entrada atual (reaproveitado como a arena)
+Chunk line_chunk;
+
+// Motor de execução: VM de bytecode (padrão) ou avaliador da AST
+typedef enum {
+    ENGINE_VM,
+    ENGINE_AST
+} Engine;
+
+Engine engine = ENGINE_VM;
+
+// Imprime a AST já otimizada antes de executar (--dump-ast)
+int dump_ast = 0;
+
+// Imprime o bytecode compilado antes de executar (--dump-bytecode)
+int dump_bytecode = 0;
+
 // ==================== ESTRUTURA DE ARGUMENTOS ====================
 
 typedef struct {
@@ -42,6 +71,12 @@ typedef struct {
     int execute_string;        // Executar string (-e)
     char* filename;           // Arquivo para executar
     char* code_string;        // Código para executar (-e)
+    int profile_alloc;        // Perfil de alocações (--memprof)
+    char* profile_csv;        // Arquivo CSV do perfil (--memprof-csv)
+    int use_ast_engine;       // Avaliador da AST em vez da VM (--engine ast)
+    int dump_ast;             // Imprime a AST otimizada (--dump-ast)
+    int dump_bytecode;        // Imprime o bytecode (--dump-bytecode)
+    char* output_file;        // Arquivo que recebe a saída (--output)
     int has_error;
     char error_message[256];
 } CommandLineArgs;
@@ -69,6 +104,12 @@ void print_command_line_help() {
         printf("  rudis -h, --help         Mostra esta ajuda\n");
         printf("  rudis -v, --version      Mostra a versão\n");
         printf("  rudis --lang pt|en       Define o idioma\n");
+        printf("  rudis --memprof          Mostra o perfil de alocações ao sair\n");
+        printf("  rudis --memprof-csv <arq> Grava o perfil de alocações em CSV ao sair\n");
+        printf("  rudis --engine vm|ast    Executa com a VM de bytecode (padrão) ou a AST\n");
+        printf("  rudis --dump-ast         Mostra a AST otimizada de cada instrução\n");
+        printf("  rudis --dump-bytecode    Mostra o bytecode de cada instrução (VM)\n");
+        printf("  rudis --output <arq>     Grava a saída do programa no arquivo\n");
         printf("\nEXEMPLOS:\n");
         printf("  rudis                         # Inicia REPL\n");
         printf("  rudis calculos.rudis          # Executa arquivo\n");
@@ -84,6 +125,12 @@ void print_command_line_help() {
         printf("  rudis -h, --help         Shows this help\n");
         printf("  rudis -v, --version      Shows version\n");
         printf("  rudis --lang pt|en       Sets language\n");
+        printf("  rudis --memprof          Shows the allocation profile on exit\n");
+        printf("  rudis --memprof-csv <file> Writes the allocation profile as CSV on exit\n");
+        printf("  rudis --engine vm|ast    Runs on the bytecode VM (default) or the AST\n");
+        printf("  rudis --dump-ast         Shows the optimized AST of each statement\n");
+        printf("  rudis --dump-bytecode    Shows the bytecode of each statement (VM)\n");
+        printf("  rudis --output <file>    Writes the program output to the file\n");
         printf("\nEXAMPLES:\n");
         printf("  rudis                         # Starts REPL\n");
         printf("  rudis calculations.rudis      # Executes file\n");
@@ -142,6 +189,64 @@ CommandLineArgs parse_arguments(int argc, char *argv[]) {
                 }
             }
         }
+        // --memprof (perfil de alocações)
+        else if (strcmp(argv[i], "--memprof") == 0) {
+            args.profile_alloc = 1;
+        }
+        // --memprof-csv arquivo
+        else if (strcmp(argv[i], "--memprof-csv") == 0) {
+            if (i + 1 < argc) {
+                args.profile_csv = argv[++i];
+            } else {
+                args.has_error = 1;
+                if (current_lang == LANG_PT) {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Erro: --memprof-csv requer o nome do arquivo");
+                } else {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Error: --memprof-csv requires a file name");
+                }
+            }
+        }
+        // --output arquivo
+        else if (strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) {
+                args.output_file = argv[++i];
+            } else {
+                args.has_error = 1;
+                if (current_lang == LANG_PT) {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Erro: --output requer o nome do arquivo");
+                } else {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Error: --output requires a file name");
+                }
+            }
+        }
+        // --dump-ast (debug do otimizador)
+        else if (strcmp(argv[i], "--dump-ast") == 0) {
+            args.dump_ast = 1;
+        }
+        // --dump-bytecode (debug do compilador)
+        else if (strcmp(argv[i], "--dump-bytecode") == 0) {
+            args.dump_bytecode = 1;
+        }
+        // --engine vm|ast
+        else if (strcmp(argv[i], "--engine") == 0) {
+            if (i + 1 < argc && 
+                (strcmp(argv[i + 1], "vm") == 0 || strcmp(argv[i + 1], "ast") == 0)) {
+                args.use_ast_engine = strcmp(argv[++i], "ast") == 0;
+            } else {
+                args.has_error = 1;
+                if (current_lang == LANG_PT) {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Erro: --engine requer 'vm' ou 'ast'");
+                } else {
+                    snprintf(args.error_message, sizeof(args.error_message),
+                             "Error: --engine requires 'vm' or 'ast'");
+                }
+            }
+        }
         // Opção desconhecida começando com -
         else if (argv[i][0] == '-') {
             args.has_error = 1;
@@ -165,9 +270,116 @@ CommandLineArgs parse_arguments(int argc, char *argv[]) {
 
 // ==================== EXECUÇÃO DE ARQUIVO ====================
 
+#define FILE_CHUNK_SIZE (1024 * 1024)   // Leitura em blocos de 1 MiB
+
+// Lê o arquivo inteiro para um buffer terminado em '\0', em blocos
+// grandes (funciona também com pipes). O buffer é liberado com a89free.
+char* load_file(const char* filename, int* out_size) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+
+    // Tamanho conhecido evita realocações; pipes caem no crescimento
+    size_t capacity = FILE_CHUNK_SIZE;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0) capacity = (size_t)size + 1;
+        rewind(file);
+    }
+
+    char* buffer = (char*)A89ALLOC(capacity);
+    size_t size = 0;
+
+    while (buffer != NULL) {
+        if (capacity - size < 2) {
+            // Cresce em dobro: custo linear no tamanho do arquivo
+            char* grown = (char*)A89ALLOC(capacity * 2);
+            if (grown != NULL) memcpy(grown, buffer, size);
+            a89free(buffer);
+            buffer = grown;
+            capacity *= 2;
+            continue;
+        }
+
+        size_t want = capacity - size - 1;
+        if (want > FILE_CHUNK_SIZE) want = FILE_CHUNK_SIZE;
+        size_t got = fread(buffer + size, 1, want, file);
+        size += got;
+        if (got < want) break;      // EOF ou erro de leitura
+    }
+
+    if (buffer != NULL && (ferror(file) || size > INT_MAX - 1)) {
+        a89free(buffer);
+        buffer = NULL;
+    }
+    fclose(file);
+
+    if (buffer == NULL) return NULL;
+    buffer[size] = '\0';
+    *out_size = (int)size;
+    return buffer;
+}
+
+// Número da linha de uma posição do buffer. As consultas vêm em ordem
+// crescente, então a contagem continua de onde parou.
+typedef struct {
+    const char* source;
+    int position;
+    int line;
+} LineCounter;
+
+static int line_at(LineCounter* counter, int position) {
+    if (position < counter->position) {
+        counter->position = 0;
+        counter->line = 1;
+    }
+    while (counter->position < position) {
+        if (counter->source[counter->position] == '\n') counter->line++;
+        counter->position++;
+    }
+    return counter->line;
+}
+
+// Início da próxima linha física a partir de position
+static int next_line_start(const char* source, int size, int position) {
+    while (position < size && source[position] != '\n') position++;
+    return position < size ? position + 1 : size;
+}
+
+// Se a instrução começa no início da sua linha física, copia a linha
+// para command (sem espaços finais). Retorna 0 se não couber ou se
+// houver outra coisa antes na linha.
+static int physical_line(const char* source, int size, int position,
+                         char* command, size_t command_size) {
+    int begin = position;
+    while (begin > 0 && source[begin - 1] != '\n') {
+        begin--;
+        if (!isspace((unsigned char)source[begin])) return 0;
+    }
+
+    int end = position;
+    while (end < size && source[end] != '\n') end++;
+    while (end > position && isspace((unsigned char)source[end - 1])) end--;
+
+    if ((size_t)(end - position) >= command_size) return 0;
+    memcpy(command, source + position, (size_t)(end - position));
+    command[end - position] = '\0';
+    return 1;
+}
+
+static void print_file_error(int line, const char* kind, const char* message) {
+    output_flush();
+    printf(ERROR_COLOR "%s (%s %d): %s\n" RESET, kind,
+           (current_lang == LANG_PT ? "linha" : "line"), line, message);
+}
+
+// O arquivo inteiro é analisado por um único lexer; cada instrução
+// pode ocupar várias linhas (ver lexer_get_next_token) e linhas não
+// têm limite de tamanho. Depois de um erro de sintaxe, a execução
+// continua na linha seguinte.
 int execute_file(const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
+    int size = 0;
+    char* source = load_file(filename, &size);
+    if (!source) {
         if (current_lang == LANG_PT) {
             fprintf(stderr, ERROR_COLOR "Erro: Não foi possível abrir arquivo '%s'\n" RESET, filename);
         } else {
@@ -175,38 +387,67 @@ int execute_file(const char* filename) {
         }
         return 1;
     }
-    
-    char line[STR_SIZE];
-    int line_number = 0;
+
     int has_errors = 0;
-    
-    while (fgets(line, sizeof(line), file)) {
-        line_number++;
-        
-        // Remove newline no final
-        size_t len = strlen(line);
-        if (len > 0 && line[len-1] == '\n') {
-            line[len-1] = '\0';
+    LineCounter lines = { source, 0, 1 };
+    char command[STR_SIZE];
+
+    Lexer lexer;
+    Parser parser;
+    lexer_init_buffer(&lexer, source, size);
+    parser_init(&parser, &lexer);
+    parser.arena = &parse_arena;
+
+    while (1) {
+        while (parser.current_token.type == TOKEN_NEWLINE ||
+               parser.current_token.type == TOKEN_SEMICOLON) {
+            parser_advance(&parser);
         }
-        
-        // Ignora linhas vazias
-        if (strlen(line) == 0) {
+        if (parser.current_token.type == TOKEN_EOF) break;
+
+        int start = parser.current_token.position;
+
+        // Comandos do REPL (vars, help, set lang...) ocupam a linha toda
+        if (physical_line(source, size, start, command, sizeof(command)) &&
+            process_command(command)) {
+            lexer_seek(&lexer, next_line_start(source, size, start));
+            parser_advance(&parser);
             continue;
         }
-        
-        // Ignora comentários
-        if (line[0] == '#' || (line[0] == '/' && line[1] == '/')) {
+
+        ASTNode* ast = parse_line(&parser);
+
+        if (parser.has_error) {
+            int error_position = parser.current_token.position;
+            if (error_position < start) error_position = start;
+            print_file_error(line_at(&lines, error_position),
+                             get_error_syntax(), parser.error_message);
+            has_errors = 1;
+
+            // Descarta o resto da linha com erro
+            arena_reset(&parse_arena);
+            parser.has_error = 0;
+            parser.error_message[0] = '\0';
+            lexer_seek(&lexer, next_line_start(source, size, error_position));
+            parser_advance(&parser);
             continue;
         }
-        
-        // Processa a linha (usa a mesma função do REPL)
-        process_input(line);
-        
-        // Verifica se houve erro no evaluator_state
-        // (você precisaria adicionar uma flag de erro no EvaluatorState)
+
+        if (ast != NULL) {
+            if (!run_ast(ast)) {
+                int error_position = evaluator_state.error.position;
+                if (error_position < start) error_position = start;
+                print_file_error(line_at(&lines, error_position),
+                                 (current_lang == LANG_PT ? "Erro" : "Error"),
+                                 evaluator_state.error.message);
+                has_errors = 1;
+            }
+            free_ast(ast);
+        }
+        arena_reset(&parse_arena);
     }
-    
-    fclose(file);
+
+    a89free(source);
     return has_errors ? 1 : 0;
 }
 
@@ -217,6 +458,36 @@ void execute_string(const char* code) {
     process_input(code);
 }
 
+// ==================== PERFIL DE ALOCAÇÕES ====================
+
+static int profile_show_table = 0;
+static const char* profile_csv_file = NULL;
+
+// Registrada com atexit(): roda depois da limpeza final, então os
+// bytes ainda vivos no relatório são vazamentos
+void finish_alloc_profile(void) {
+    if (profile_show_table) {
+        a89profile_report();
+    }
+    if (profile_csv_file != NULL) {
+        a89profile_write_csv(profile_csv_file);
+    }
+}
+
+// ==================== SAÍDA ====================
+
+// Grava o que restou no buffer de saída; retorna 0 (com aviso em
+// stderr) se alguma escrita falhou, por exemplo disco cheio
+static int finish_output(void) {
+    if (output_close()) return 1;
+    if (current_lang == LANG_PT) {
+        fprintf(stderr, ERROR_COLOR "Erro: não foi possível gravar toda a saída\n" RESET);
+    } else {
+        fprintf(stderr, ERROR_COLOR "Error: could not write all of the output\n" RESET);
+    }
+    return 0;
+}
+
 // ==================== FUNÇÕES EXISTENTES (mantidas) ====================
 
 void print_banner() {
@@ -243,91 +514,131 @@ void handle_help_command(const char* argument) {
 }
 
 void list_variables() {
-    printf(CYAN "%s\n" RESET, get_text_variables_header());
+    output_printf(CYAN "%s\n" RESET, get_text_variables_header());
     
-    if (evaluator_state.variable_count == 0) {
-        printf("%s\n", get_text_no_variables());
-        return;
-    }
-    
-    Variable* current = evaluator_state.variables;
+    // Ordem de criação: a mesma a cada execução.
+    // Slots criados apenas por leitura (ainda sem valor) não são listados.
     int count = 0;
     
-    while (current != NULL) {
-        printf("  %s = ", current->name);
-        print_value(current->value, evaluator_state.decimal_places);
-        printf("\n");
-        current = current->next;
+    for (int i = 0; i < evaluator_state.variable_count; i++) {
+        if (evaluator_state.slots[i].type == VAL_UNDEFINED) continue;
+        output_printf("  %s = ", evaluator_state.variables[i].name);
+        print_value(evaluator_state.slots[i], evaluator_state.decimal_places);
+        output_char('\n');
         count++;
     }
     
-    printf("Total: %d variáveis\n", count);
-}
-
-void process_input(const char* input) {
-    // Ignora entradas vazias
-    if (strlen(input) == 0) {
+    if (count == 0) {
+        output_printf("%s\n", get_text_no_variables());
         return;
     }
     
-    // Comandos especiais
+    output_printf("Total: %d variáveis\n", count);
+}
+
+// Executa um comando especial do REPL; retorna 0 se input não é comando
+int process_command(const char* input) {
     if (strncmp(input, "help", 4) == 0) {
         const char* argument = input + 4;
         while (*argument == ' ') argument++;
+        output_flush();     // help, clear e memprof ainda usam printf
         handle_help_command(argument);
-        return;
+        return 1;
     }
     else if (strcmp(input, "clear") == 0) {
+        output_flush();
         clear_screen();
-        return;
+        return 1;
     }
     else if (strcmp(input, "vars") == 0) {
         list_variables();
-        return;
+        return 1;
+    }
+    else if (strcmp(input, "memprof") == 0) {
+        output_flush();
+        a89profile_report();
+        return 1;
     }
     else if (strcmp(input, "reset") == 0) {
         evaluator_free(&evaluator_state);
         evaluator_init(&evaluator_state);
-        printf(INFO_COLOR "%s\n" RESET, get_text_reset_success());
-        return;
+        output_printf(INFO_COLOR "%s\n" RESET, get_text_reset_success());
+        return 1;
     }
     else if (strcmp(input, "set lang pt") == 0) {
         set_language(LANG_PT);
-        printf(INFO_COLOR "%s\n" RESET, get_text_language_changed_pt());
-        return;
+        output_printf(INFO_COLOR "%s\n" RESET, get_text_language_changed_pt());
+        return 1;
     }
     else if (strcmp(input, "set lang en") == 0) {
         set_language(LANG_EN);
-        printf(INFO_COLOR "%s\n" RESET, get_text_language_changed_en());
-        return;
+        output_printf(INFO_COLOR "%s\n" RESET, get_text_language_changed_en());
+        return 1;
     }
     else if (strcmp(input, "exit") == 0 || strcmp(input, "quit") == 0) {
-        printf(INFO_COLOR "%s\n" RESET, get_text_goodbye());
+        output_printf(INFO_COLOR "%s\n" RESET, get_text_goodbye());
+        output_close();
         exit(0);
     }
+    return 0;
+}
+
+// Avalia a AST e imprime o resultado; retorna 0 em caso de erro
+// (mensagem em evaluator_state.error)
+int run_ast(ASTNode* ast) {
+    optimize_ast(&evaluator_state, &parse_arena, ast);
+    if (dump_ast) {
+        output_flush();     // print_ast escreve com printf
+        print_ast(ast, 0, evaluator_state.decimal_places);
+    }
+    resolve_variables(&evaluator_state, ast);
+
+    // A VM cai no avaliador da AST se a AST não puder ser compilada
+    EvaluatorResult result;
+    if (engine == ENGINE_VM && compile_ast(&line_chunk, ast)) {
+        if (dump_bytecode) chunk_disassemble(&line_chunk);
+        result = vm_execute(&evaluator_state, &line_chunk);
+        chunk_reset(&line_chunk);
+    } else {
+        result = evaluate(&evaluator_state, ast);
+    }
+    
+    if (result.success && !result.is_assignment && result.value.type != VAL_NULL) {
+        print_value(result.value, evaluator_state.decimal_places); 
+        output_char('\n');
+    }
+    value_release(&result.value);
+    output_statement_end();
+    return result.success;
+}
+
+void process_input(const char* input) {
+    // Ignora entradas vazias
+    if (strlen(input) == 0) {
+        return;
+    }
+    
+    // Comandos especiais
+    if (process_command(input)) {
+        return;
+    }
 
     // Processa entrada normal
     Lexer lexer;
     lexer_init(&lexer, input);
     
-    ASTNode* ast = parse(&lexer);
+    ASTNode* ast = parse(&lexer, &parse_arena);
     
     if (ast != NULL) {
-        EvaluatorResult result = evaluate(&evaluator_state, ast);
-        
-        if (result.success) {
-            if (!result.is_assignment && result.value.type != VAL_NULL) {
-                print_value(result.value, evaluator_state.decimal_places); 
-                printf("\n");
-            }
-        } else {
+        if (!run_ast(ast)) {
+            output_flush();
             printf(ERROR_COLOR "%s: %s\n" RESET, 
                    (current_lang == LANG_PT ? "Erro" : "Error"), 
-                   result.error_message);
+                   evaluator_state.error.message);
         }
-        
         free_ast(ast);
     }
+    arena_reset(&parse_arena);
 }
 
 // ==================== FUNÇÃO REPL ====================
@@ -339,6 +650,7 @@ void run_repl() {
     
     // Loop principal do REPL
     while (1) {
+        output_flush();     // Resultados pendentes antes do prompt
         printf(PROMPT_COLOR "rudis> " RESET);
         fflush(stdout);
         
@@ -383,30 +695,65 @@ int main(int argc, char *argv[]) {
         return 0;
     }
     
+    // Perfil de alocações (--memprof / --memprof-csv)
+    if (args.profile_alloc || args.profile_csv) {
+        profile_show_table = args.profile_alloc;
+        profile_csv_file = args.profile_csv;
+        a89profile_start();
+        atexit(finish_alloc_profile);
+    }
+    
+    if (args.use_ast_engine) {
+        engine = ENGINE_AST;
+    }
+    dump_ast = args.dump_ast;
+    dump_bytecode = args.dump_bytecode;
+    
+    // Saída em arquivo (--output)
+    if (args.output_file && !output_open_file(args.output_file)) {
+        if (current_lang == LANG_PT) {
+            fprintf(stderr, ERROR_COLOR "Erro: Não foi possível criar arquivo '%s'\n" RESET, args.output_file);
+        } else {
+            fprintf(stderr, ERROR_COLOR "Error: Could not create file '%s'\n" RESET, args.output_file);
+        }
+        return 1;
+    }
+    
     // Inicializa o evaluator
     evaluator_init(&evaluator_state);
+    arena_init(&parse_arena, ARENA_BLOCK_SIZE);
+    chunk_init(&line_chunk);
     
     // Executa string (-e)
     if (args.execute_string) {
         execute_string(args.code_string);
+        int result = finish_output() ? 0 : 1;
         evaluator_free(&evaluator_state);
+        arena_free(&parse_arena);
+        chunk_free(&line_chunk);
         //a89check_leaks();
-        return 0;
+        return result;
     }
     
     // Executa arquivo
     if (args.filename) {
         int result = execute_file(args.filename);
+        if (!finish_output()) result = 1;
         evaluator_free(&evaluator_state);
+        arena_free(&parse_arena);
+        chunk_free(&line_chunk);
         //a89check_leaks();
         return result;
     }
     
     // Modo REPL (default)
     run_repl();
+    int result = finish_output() ? 0 : 1;
     
     // Limpeza final
     evaluator_free(&evaluator_state);
+    arena_free(&parse_arena);
+    chunk_free(&line_chunk);
     //a89check_leaks();   
-    return 0;
-}
\ No newline at end of file
+    return result;
+}
\ No newline at end of file
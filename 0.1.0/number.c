@@ -0,0 +1,249 @@
+#include <math.h>
+#include <stdint.h>
+
+#include "number.h"
+#include "functions.h"
+#include "lang.h"
+
+#define TWO_POW_63 9223372036854775808.0
+#define MAX_EXACT_FACTORIAL 20      // 20! < 2^63 < 21!
+
+static void set_integer(Value* value, int64_t integer) {
+    value->is_integer = 1;
+    value->as.integer = integer;
+}
+
+static void set_double(Value* value, double number) {
+    value->is_integer = 0;
+    value->as.number = number;
+}
+
+// Valor inteiro exato em int64 (de um inteiro ou de um double como 8.0)
+static int exact_integer(const Value* value, int64_t* integer) {
+    if (value->is_integer) {
+        *integer = value->as.integer;
+        return 1;
+    }
+    double number = value->as.number;
+    if (number >= -TWO_POW_63 && number < TWO_POW_63 && number == floor(number)) {
+        *integer = (int64_t)number;
+        return 1;
+    }
+    return 0;   // Fração, fora de int64, inf ou nan
+}
+
+int64_t number_from_bits(uint64_t bits) {
+    if (bits <= (uint64_t)INT64_MAX) return (int64_t)bits;
+    return -(int64_t)(~bits) - 1;
+}
+
+static int multiply_overflows(int64_t a, int64_t b) {
+    if (a == 0 || b == 0) return 0;
+    if (a > 0) {
+        return b > 0 ? a > INT64_MAX / b : b < INT64_MIN / a;
+    }
+    return b > 0 ? a < INT64_MIN / b : a < INT64_MAX / b;
+}
+
+//===================================================================
+// ARITMÉTICA
+//===================================================================
+void number_add(Value* left, Value right) {
+    if (left->is_integer && right.is_integer) {
+        int64_t a = left->as.integer;
+        int64_t b = right.as.integer;
+        if (b >= 0 ? a <= INT64_MAX - b : a >= INT64_MIN - b) {
+            left->as.integer = a + b;
+            return;
+        }
+    }
+    set_double(left, VALUE_AS_DOUBLE(*left) + VALUE_AS_DOUBLE(right));
+}
+
+void number_subtract(Value* left, Value right) {
+    if (left->is_integer && right.is_integer) {
+        int64_t a = left->as.integer;
+        int64_t b = right.as.integer;
+        if (b >= 0 ? a >= INT64_MIN + b : a <= INT64_MAX + b) {
+            left->as.integer = a - b;
+            return;
+        }
+    }
+    set_double(left, VALUE_AS_DOUBLE(*left) - VALUE_AS_DOUBLE(right));
+}
+
+void number_multiply(Value* left, Value right) {
+    if (left->is_integer && right.is_integer &&
+        !multiply_overflows(left->as.integer, right.as.integer)) {
+        left->as.integer *= right.as.integer;
+        return;
+    }
+    set_double(left, VALUE_AS_DOUBLE(*left) * VALUE_AS_DOUBLE(right));
+}
+
+NumberStatus number_divide(Value* left, Value right) {
+    if (left->is_integer && right.is_integer) {
+        int64_t a = left->as.integer;
+        int64_t b = right.as.integer;
+        if (b == 0) return NUMBER_DIVISION_BY_ZERO;
+        // Divisão exata fica inteira (INT64_MIN / -1 não cabe)
+        if (!(a == INT64_MIN && b == -1) && a % b == 0) {
+            left->as.integer = a / b;
+            return NUMBER_OK;
+        }
+    }
+    double divisor = VALUE_AS_DOUBLE(right);
+    if (divisor == 0) return NUMBER_DIVISION_BY_ZERO;
+    set_double(left, VALUE_AS_DOUBLE(*left) / divisor);
+    return NUMBER_OK;
+}
+
+NumberStatus number_modulo(Value* left, Value right) {
+    if (left->is_integer && right.is_integer) {
+        int64_t b = right.as.integer;
+        if (b == 0) return NUMBER_MODULO_BY_ZERO;
+        // x % -1 é sempre 0 (e INT64_MIN % -1 estouraria)
+        left->as.integer = (b == -1) ? 0 : left->as.integer % b;
+        return NUMBER_OK;
+    }
+
+    // Doubles são truncados para inteiro, como antes
+    double a = trunc(VALUE_AS_DOUBLE(*left));
+    double b = trunc(VALUE_AS_DOUBLE(right));
+    if (b == 0) return NUMBER_MODULO_BY_ZERO;
+    if (fabs(a) < TWO_POW_63 && fabs(b) < TWO_POW_63) {
+        int64_t divisor = (int64_t)b;
+        set_integer(left, divisor == -1 ? 0 : (int64_t)a % divisor);
+    } else {
+        set_double(left, fmod(a, b));
+    }
+    return NUMBER_OK;
+}
+
+void number_power(Value* left, Value right) {
+    if (left->is_integer && right.is_integer && right.as.integer >= 0) {
+        // Exponenciação por quadrados, parando no primeiro overflow
+        int64_t base = left->as.integer;
+        int64_t exponent = right.as.integer;
+        int64_t result = 1;
+        for (;;) {
+            if (exponent & 1) {
+                if (multiply_overflows(result, base)) break;
+                result *= base;
+            }
+            exponent >>= 1;
+            if (exponent == 0) {
+                left->as.integer = result;
+                return;
+            }
+            if (multiply_overflows(base, base)) break;
+            base *= base;
+        }
+    }
+    set_double(left, power(VALUE_AS_DOUBLE(*left), VALUE_AS_DOUBLE(right)));
+}
+
+//===================================================================
+// BIT A BIT
+//===================================================================
+// Deslocamento lógico para a esquerda (count negativo: para a direita)
+static uint64_t shift_bits(uint64_t bits, int64_t count) {
+    if (count <= -64 || count >= 64) return 0;
+    return count >= 0 ? bits << count : bits >> -count;
+}
+
+int is_bitwise_operator(char operator) {
+    return operator == '&' || operator == '|' || operator == '~' ||
+           operator == '<' || operator == '>';
+}
+
+NumberStatus number_bitwise(char operator, Value* left, Value right) {
+    int64_t a;
+    int64_t b;
+    if (!exact_integer(left, &a) || !exact_integer(&right, &b)) {
+        return NUMBER_NOT_INTEGER;
+    }
+
+    uint64_t bits = (uint64_t)a;
+    switch (operator) {
+        case '&': bits &= (uint64_t)b; break;
+        case '|': bits |= (uint64_t)b; break;
+        case '~': bits ^= (uint64_t)b; break;
+        case '<': bits = shift_bits(bits, b); break;
+        case '>': bits = shift_bits(bits, b == INT64_MIN ? 64 : -b); break;
+        default:  return NUMBER_INVALID_OPERATOR;
+    }
+    set_integer(left, number_from_bits(bits));
+    return NUMBER_OK;
+}
+
+NumberStatus number_bitwise_not(Value* operand) {
+    int64_t a;
+    if (!exact_integer(operand, &a)) return NUMBER_NOT_INTEGER;
+    set_integer(operand, ~a);
+    return NUMBER_OK;
+}
+
+//===================================================================
+// OPERAÇÕES UNÁRIAS
+//===================================================================
+void number_negate(Value* operand) {
+    if (operand->is_integer && operand->as.integer != INT64_MIN) {
+        operand->as.integer = -operand->as.integer;
+        return;
+    }
+    set_double(operand, -VALUE_AS_DOUBLE(*operand));
+}
+
+void number_factorial(Value* operand) {
+    if (operand->is_integer && operand->as.integer >= 0 &&
+        operand->as.integer <= MAX_EXACT_FACTORIAL) {
+        int64_t result = 1;
+        for (int64_t i = 2; i <= operand->as.integer; i++) {
+            result *= i;
+        }
+        operand->as.integer = result;
+        return;
+    }
+    set_double(operand, factorial(VALUE_AS_DOUBLE(*operand)));
+}
+
+//===================================================================
+// DESPACHO PELO OPERADOR
+//===================================================================
+NumberStatus number_binary(char operator, Value* left, Value right) {
+    switch (operator) {
+        case '+': number_add(left, right); return NUMBER_OK;
+        case '-': number_subtract(left, right); return NUMBER_OK;
+        case '*': number_multiply(left, right); return NUMBER_OK;
+        case '/': return number_divide(left, right);
+        case '%': return number_modulo(left, right);
+        case '^': number_power(left, right); return NUMBER_OK;
+        default:  return number_bitwise(operator, left, right);
+    }
+}
+
+NumberStatus number_unary(char operator, Value* operand) {
+    switch (operator) {
+        case '-': number_negate(operand); return NUMBER_OK;
+        case '!': number_factorial(operand); return NUMBER_OK;
+        case '~': return number_bitwise_not(operand);
+        default:  return NUMBER_INVALID_OPERATOR;
+    }
+}
+
+const char* number_error_message(NumberStatus status) {
+    switch (status) {
+        case NUMBER_DIVISION_BY_ZERO:
+            return current_lang == LANG_PT ? "Divisão por zero" : "Division by zero";
+        case NUMBER_MODULO_BY_ZERO:
+            return current_lang == LANG_PT ? "Módulo por zero" : "Modulo by zero";
+        case NUMBER_NOT_INTEGER:
+            return current_lang == LANG_PT ? "Operações bit a bit requerem inteiros"
+                                           : "Bitwise operations require integers";
+        case NUMBER_INVALID_OPERATOR:
+            return current_lang == LANG_PT ? "Operador inválido" : "Invalid operator";
+        default:
+            return "";
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef NUMBER_H
+#define NUMBER_H
+
+#include "value.h"
+
+/********************************************************************
+ARITMÉTICA DOS NÚMEROS - RUDIS
+
+Um VAL_NUMBER guarda um inteiro exato de 64 bits (is_integer = 1,
+as.integer) ou um double (as.number). Literais decimais sem ponto nem
+expoente que cabem em int64 viram inteiros. Literais hexadecimais e
+binários são sempre inteiros: acima de INT64_MAX valem o int64 com os
+mesmos bits (0xFFFFFFFFFFFFFFFF == ~0 == -1). As funções matemáticas,
+estatísticas e financeiras devolvem double.
+
+Entre dois inteiros, + - * ^ e ! são calculados em int64 com
+verificação de overflow e / dá inteiro quando a divisão é exata. Se o
+resultado não cabe em int64 (ou a divisão não é exata), a operação é
+refeita em double: o valor é o mesmo de antes, quando tudo era double.
+Com um operando double, a conta é em double.
+
+% trunca os operandos para inteiro, agora em 64 bits (antes em int,
+errado acima de 2^31), e o resultado é inteiro.
+
+Operadores bit a bit, sobre os 64 bits em complemento de dois:
+    a & b    e             ~a       negação
+    a | b    ou            a << n   deslocamento à esquerda
+    a ~ b    ou exclusivo  a >> n   deslocamento lógico à direita
+Deslocamentos de 64 ou mais dão 0 e um n negativo desloca para o
+outro lado. Os operandos precisam ter valor inteiro em int64 (um
+double como 8.0 serve, 8.5 não). Como em Lua, ligam mais fraco que
++ e -: | < ~ < & < << >> < + -.
+
+No AST e no bytecode << e >> são os operadores '<' e '>'.
+********************************************************************/
+
+typedef enum {
+    NUMBER_OK,
+    NUMBER_DIVISION_BY_ZERO,
+    NUMBER_MODULO_BY_ZERO,
+    NUMBER_NOT_INTEGER,         // Operando bit a bit sem valor inteiro
+    NUMBER_INVALID_OPERATOR
+} NumberStatus;
+
+// Operações entre dois VAL_NUMBER: o resultado fica em *left
+void number_add(Value* left, Value right);
+void number_subtract(Value* left, Value right);
+void number_multiply(Value* left, Value right);
+NumberStatus number_divide(Value* left, Value right);
+NumberStatus number_modulo(Value* left, Value right);
+void number_power(Value* left, Value right);
+
+// & | ~ < (<<) > (>>)
+NumberStatus number_bitwise(char operator, Value* left, Value right);
+
+// Operações sobre um VAL_NUMBER, no lugar
+void number_negate(Value* operand);
+void number_factorial(Value* operand);
+NumberStatus number_bitwise_not(Value* operand);
+
+// Despacho pelo caractere do operador (avaliador da AST)
+NumberStatus number_binary(char operator, Value* left, Value right);
+NumberStatus number_unary(char operator, Value* operand);
+
+int is_bitwise_operator(char operator);
+
+// Os 64 bits em complemento de dois como int64 (sem depender da
+// conversão de um uint64_t acima de INT64_MAX)
+int64_t number_from_bits(uint64_t bits);
+
+// Mensagem do erro no idioma atual
+const char* number_error_message(NumberStatus status);
+
+#endif // NUMBER_H
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "numfmt.h"
+
+#define TWO_POW_51 2251799813685248.0
+#define TWO_POW_52 4503599627370496.0
+#define TWO_POW_53 9007199254740992.0
+#define MAX_EXACT_POWER 22
+#define MAX_SHORTEST_DIGITS 17
+
+// Potências de 10 representadas exatamente em double
+static const double powers_of_ten[MAX_EXACT_POWER + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Escreve os dígitos de value (sem sinal) e devolve quantos foram escritos
+static int write_uint64(char* buffer, uint64_t value) {
+    char digits[24];
+    int count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (int i = 0; i < count; i++) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+// Escreve value com exatamente width dígitos (zeros à esquerda)
+static void write_padded(char* buffer, uint64_t value, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+        buffer[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+//===================================================================
+// CASAS FIXAS
+//===================================================================
+/*
+ * p = número * 10^casas é arredondado uma vez; fma() devolve o erro
+ * exato desse produto, então p + erro é o valor exato e dá para decidir
+ * o arredondamento para inteiro como o printf: para o mais próximo e,
+ * no empate exato, para o par.
+ */
+int format_number_fixed(char* buffer, double number, int decimal_places) {
+    if (isfinite(number) && decimal_places >= 0 && decimal_places <= MAX_EXACT_POWER) {
+        double magnitude = fabs(number);
+        double scale = powers_of_ten[decimal_places];
+        double scaled = magnitude * scale;
+
+        if (scaled < TWO_POW_52) {
+            double error = fma(magnitude, scale, -scaled);   // exato: valor = scaled + error
+            double integer = floor(scaled);
+            double half_distance = (scaled - integer) - 0.5; // exato para scaled < 2^52
+
+            uint64_t units = (uint64_t)integer;
+            if (half_distance > -error) {
+                units++;
+            } else if (half_distance == -error && (units & 1)) {
+                units++;
+            }
+
+            char* out = buffer;
+            if (signbit(number)) *out++ = '-';
+
+            uint64_t divisor = (uint64_t)scale;
+            out += write_uint64(out, units / divisor);
+            if (decimal_places > 0) {
+                *out++ = '.';
+                write_padded(out, units % divisor, decimal_places);
+                out += decimal_places;
+            }
+            *out = '\0';
+            return (int)(out - buffer);
+        }
+    }
+
+    return snprintf(buffer, NUMBER_BUFFER_SIZE, "%.*f", decimal_places, number);
+}
+
+//===================================================================
+// MENOR REPRESENTAÇÃO
+//===================================================================
+/*
+ * Procura os dígitos mais curtos de um double positivo finito:
+ * valor == digits * 10^exponent, sem zeros à direita em digits.
+ *
+ * Para cada precisão P, o candidato é o inteiro mais próximo de
+ * valor * 10^s (s = P - 1 - expoente decimal). Enquanto o candidato e
+ * 10^|s| são exatos em double, uma multiplicação ou divisão IEEE lê o
+ * texto de volta corretamente arredondado, então a comparação com o
+ * valor original confirma a ida e volta sem strtod. Quando isso não é
+ * possível, 17 dígitos são sempre suficientes: eles saem do produto
+ * exato (com fma) quando 10^s é exato e, nos demais casos (expoentes
+ * muito grandes ou muito pequenos), de snprintf("%.*e") com
+ * confirmação por strtod.
+ */
+static void strip_zeros(uint64_t* digits, int* exponent) {
+    while (*digits != 0 && *digits % 10 == 0) {
+        *digits /= 10;
+        (*exponent)++;
+    }
+}
+
+// 17 dígitos corretamente arredondados de value * 10^shift (0 <= shift <= 22)
+static int seventeen_digits(double value, int shift, uint64_t* digits) {
+    double scale = powers_of_ten[shift];
+    double scaled = value * scale;
+    if (scaled < 1e16 || scaled >= 1e17) return 0;     // Estimativa do expoente errada
+
+    double error = fma(value, scale, -scaled);          // exato: valor = scaled + error
+    double whole = floor(error);
+    double fraction = error - whole;
+    uint64_t units = (uint64_t)scaled + (uint64_t)(int64_t)whole;
+    if (fraction > 0.5 || (fraction == 0.5 && (units & 1))) units++;
+
+    *digits = units;
+    return 1;
+}
+
+static void shortest_digits(double value, uint64_t* digits, int* exponent) {
+    int decimal_exponent = (int)floor(log10(value));
+    int precision = 1;
+
+    for (; precision <= MAX_SHORTEST_DIGITS; precision++) {
+        int shift = precision - 1 - decimal_exponent;
+        if (shift > MAX_EXACT_POWER || shift < -MAX_EXACT_POWER) break;
+
+        double scaled = (shift >= 0) ? value * powers_of_ten[shift]
+                                     : value / powers_of_ten[-shift];
+        double candidate = floor(scaled + 0.5);
+        if (candidate >= TWO_POW_53) break;
+
+        // Perto de 2^53 o produto arredondado pode errar o inteiro mais
+        // próximo por um: os vizinhos também são testados
+        int neighbours = (scaled >= TWO_POW_51) ? 1 : 0;
+        for (double delta = -neighbours; delta <= neighbours; delta++) {
+            double tried = candidate + delta;
+            if (tried >= TWO_POW_53) continue;
+
+            double back = (shift >= 0) ? tried / powers_of_ten[shift]
+                                       : tried * powers_of_ten[-shift];
+            if (back == value) {
+                *digits = (uint64_t)tried;
+                *exponent = -shift;
+                strip_zeros(digits, exponent);
+                return;
+            }
+        }
+    }
+
+    // Nenhuma precisão até 16 deu certo: 17 dígitos sempre voltam
+    int shift = MAX_SHORTEST_DIGITS - 1 - decimal_exponent;
+    if (precision == MAX_SHORTEST_DIGITS && shift >= 0 && shift <= MAX_EXACT_POWER &&
+        seventeen_digits(value, shift, digits)) {
+        *exponent = -shift;
+        strip_zeros(digits, exponent);
+        return;
+    }
+
+    // Caminho lento: a menor precisão de snprintf que volta ao mesmo valor
+    char text[40];
+    if (precision > MAX_SHORTEST_DIGITS) precision = MAX_SHORTEST_DIGITS;
+    for (; precision <= MAX_SHORTEST_DIGITS; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (strtod(text, NULL) == value || precision == MAX_SHORTEST_DIGITS) break;
+    }
+
+    // text = "d.dddde[+-]xx"
+    uint64_t accumulated = 0;
+    int fraction_digits = 0;
+    char* cursor = text;
+    for (; *cursor != 'e'; cursor++) {
+        if (*cursor == '.') continue;
+        accumulated = accumulated * 10 + (uint64_t)(*cursor - '0');
+        if (cursor > text + 1) fraction_digits++;
+    }
+    *digits = accumulated;
+    *exponent = atoi(cursor + 1) - fraction_digits;
+    strip_zeros(digits, exponent);
+}
+
+// Notação com expoente no estilo do %g: 1e+09, 2.5e-12
+static int write_exponential(char* buffer, uint64_t digits, int exponent) {
+    char text[24];
+    int count = write_uint64(text, digits);
+    int leading_exponent = exponent + count - 1;
+
+    char* out = buffer;
+    *out++ = text[0];
+    if (count > 1) {
+        *out++ = '.';
+        memcpy(out, text + 1, count - 1);
+        out += count - 1;
+    }
+    *out++ = 'e';
+    *out++ = (leading_exponent < 0) ? '-' : '+';
+    int magnitude = abs(leading_exponent);
+    if (magnitude < 10) *out++ = '0';
+    out += write_uint64(out, (uint64_t)magnitude);
+    *out = '\0';
+    return (int)(out - buffer);
+}
+
+// Notação decimal comum: 1234.5, 0.000125, 42
+static int write_plain(char* buffer, uint64_t digits, int exponent) {
+    char text[24];
+    int count = write_uint64(text, digits);
+    char* out = buffer;
+
+    if (exponent >= 0) {
+        memcpy(out, text, count);
+        out += count;
+        for (int i = 0; i < exponent; i++) *out++ = '0';
+    } else if (count + exponent > 0) {
+        int integer_digits = count + exponent;
+        memcpy(out, text, integer_digits);
+        out += integer_digits;
+        *out++ = '.';
+        memcpy(out, text + integer_digits, count - integer_digits);
+        out += count - integer_digits;
+    } else {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = 0; i < -(count + exponent); i++) *out++ = '0';
+        memcpy(out, text, count);
+        out += count;
+    }
+    *out = '\0';
+    return (int)(out - buffer);
+}
+
+// Fora de [1e-9, 1e9) o texto usa expoente (regra de format_number)
+static int needs_exponent(double magnitude) {
+    return magnitude >= 1e9 || (magnitude <= 1e-9 && magnitude != 0);
+}
+
+int format_number_shortest(char* buffer, double number) {
+    // Casos especiais primeiro
+    if (isnan(number)) {
+        strcpy(buffer, "nan");
+        return 3;
+    }
+    if (isinf(number)) {
+        strcpy(buffer, number > 0 ? "inf" : "-inf");
+        return number > 0 ? 3 : 4;
+    }
+    if (number == 0) {
+        strcpy(buffer, "0");
+        return 1;
+    }
+
+    char* out = buffer;
+    double magnitude = fabs(number);
+    if (number < 0) *out++ = '-';
+
+    uint64_t digits;
+    int exponent;
+    shortest_digits(magnitude, &digits, &exponent);
+
+    // Como no %g, valores pequenos também usam expoente (1.5e-05)
+    if (magnitude >= 1e9 || magnitude < 1e-4) {
+        out += write_exponential(out, digits, exponent);
+    } else {
+        out += write_plain(out, digits, exponent);
+    }
+    return (int)(out - buffer);
+}
+
+int format_number(char* buffer, double number, int decimal_places) {
+    if (decimal_places < 0 || !isfinite(number) || needs_exponent(fabs(number))) {
+        return format_number_shortest(buffer, number);
+    }
+    return format_number_fixed(buffer, number, decimal_places);
+}
+
+//===================================================================
+// INTEIROS
+//===================================================================
+int format_integer(char* buffer, int64_t number, int decimal_places) {
+    char* out = buffer;
+
+    // Módulo em uint64_t: -INT64_MIN não cabe em int64_t
+    uint64_t magnitude = (uint64_t)number;
+    if (number < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    out += write_uint64(out, magnitude);
+
+    if (decimal_places > 0) {
+        *out++ = '.';
+        memset(out, '0', (size_t)decimal_places);
+        out += decimal_places;
+    }
+    *out = '\0';
+    return (int)(out - buffer);
+}
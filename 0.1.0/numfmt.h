@@ -0,0 +1,37 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+/********************************************************************
+FORMATAÇÃO DE NÚMEROS - RUDIS
+
+Converte double em texto sem passar por snprintf nos casos comuns.
+As funções escrevem em um buffer do chamador (NUMBER_BUFFER_SIZE
+bytes), terminam com '\0' e devolvem o comprimento escrito.
+
+- format_number_fixed: mesmo texto de printf("%.*f"), inclusive o
+  arredondamento (metade para o par, sobre o valor binário exato) e o
+  "-0.00" de negativos pequenos. Caminho rápido com inteiros de 64
+  bits quando |número| * 10^casas < 2^52; fora disso usa snprintf.
+- format_number_shortest: o menor número de dígitos que, lido de
+  volta, dá exatamente o mesmo double (0.1 -> "0.1", 1/3 ->
+  "0.3333333333333333"). Usa notação com expoente (1e+09, 2.5e-05)
+  fora de [1e-4, 1e9), como o %g usado antes.
+- format_number: a regra de number_to_string_value(). Com
+  decimal_places < 0 usa o formato mais curto, senão casas fixas
+  (setdec). Fora de [1e-9, 1e9) usa sempre o formato com expoente.
+- format_integer: inteiros exatos (number.h), sempre com todos os
+  dígitos; com casas > 0 completa com ".000", como format_number_fixed
+  faria com o mesmo valor em double.
+********************************************************************/
+
+#include <stdint.h>
+
+// Cabe qualquer double em casas fixas (até 309 dígitos inteiros + 15 casas)
+#define NUMBER_BUFFER_SIZE 512
+
+int format_number_fixed(char* buffer, double number, int decimal_places);
+int format_number_shortest(char* buffer, double number);
+int format_number(char* buffer, double number, int decimal_places);
+int format_integer(char* buffer, int64_t number, int decimal_places);
+
+#endif // NUMFMT_H
@@ -0,0 +1,132 @@
+#include "optimizer.h"
+#include "builtins.h"
+
+#define MIN_CONCAT_PARTS 3
+
+static int is_constant(ASTNode* node) {
+    return node != NULL && (node->type == NODE_NUMBER || node->type == NODE_STRING);
+}
+
+// Transforma o nó em constante; o valor passa a pertencer ao nó.
+// Todo nó tem espaço para um Value (AST_NODE_SIZE), então a troca é
+// feita no lugar.
+static void replace_with_constant(ASTNode* node, Value value) {
+    free_ast(node);
+
+    node->type = (value.type == VAL_NUMBER) ? NODE_NUMBER : NODE_STRING;
+    node->operator = '\0';
+    node->as.value = value;
+}
+
+// Calcula o nó (com filhos já constantes) e o substitui pelo resultado
+static void fold_node(EvaluatorState* state, ASTNode* node) {
+    EvaluatorResult result = evaluate(state, node);
+
+    // Erros ficam para a execução
+    if (!result.success) return;
+
+    if (result.value.type != VAL_NUMBER && result.value.type != VAL_STRING) {
+        value_release(&result.value);
+        return;
+    }
+    replace_with_constant(node, result.value);
+}
+
+// Nós que podem ser dobrados, com os filhos já visitados
+static int is_foldable(ASTNode* node) {
+    switch (node->type) {
+        case NODE_BINARY_OP:
+            return is_constant(node->as.binary.left) && is_constant(node->as.binary.right);
+
+        case NODE_UNARY_OP:
+            return is_constant(node->as.unary.operand);
+
+        case NODE_FUNCTION:
+            for (int i = 0; i < node->as.call.arg_count; i++) {
+                if (!is_constant(node->as.call.args[i])) return 0;
+            }
+            if (node->as.call.builtin_id < 0 || node->as.call.builtin_id >= BUILTIN_COUNT) return 0;
+            return builtin_table[node->as.call.builtin_id].pure;
+
+        default:
+            return 0;
+    }
+}
+
+//===================================================================
+// CADEIAS DE CONCATENAÇÃO
+//===================================================================
+static int is_plus(const ASTNode* node) {
+    return node != NULL && node->type == NODE_BINARY_OP && node->operator == '+';
+}
+
+/*
+ * Transforma a cadeia ((p0 + p1) + p2) + ... cujo '+' mais externo é
+ * node em um NODE_CONCAT com os operandos p0..pn. Se p0 já for um
+ * NODE_CONCAT (cadeia entre parênteses), os seus operandos entram no
+ * lugar dele: a avaliação da esquerda para a direita é a mesma.
+ */
+static void gather_concat_chain(Arena* arena, ASTNode* node) {
+    int links = 0;
+    int has_text = 0;
+    ASTNode* first = node;
+
+    while (is_plus(first)) {
+        if (first->as.binary.right->type == NODE_STRING) has_text = 1;
+        links++;
+        first = first->as.binary.left;
+    }
+
+    int first_count = 1;
+    if (first->type == NODE_CONCAT) {
+        first_count = first->as.concat.count;
+        has_text = 1;
+    } else if (first->type == NODE_STRING) {
+        has_text = 1;
+    }
+
+    int count = first_count + links;
+    if (count < MIN_CONCAT_PARTS || !has_text) return;
+
+    ASTNode** parts = (ASTNode**)arena_alloc(arena, count * sizeof(ASTNode*));
+    if (!parts) return;     // Fica como '+' encadeado
+
+    int index = count;
+    for (ASTNode* link = node; is_plus(link); link = link->as.binary.left) {
+        parts[--index] = link->as.binary.right;
+    }
+    if (first->type == NODE_CONCAT) {
+        memcpy(parts, first->as.concat.parts, first_count * sizeof(ASTNode*));
+    } else {
+        parts[0] = first;
+    }
+
+    // O nó de concatenação não é maior que o binário: troca no lugar
+    node->type = NODE_CONCAT;
+    node->operator = '\0';
+    node->as.concat.parts = parts;
+    node->as.concat.count = count;
+}
+
+// Na saída de cada nó (filhos já dobrados), sem recursão
+void optimize_ast(EvaluatorState* state, Arena* arena, ASTNode* node) {
+    ASTWalk walk;
+    int leaving;
+
+    ast_walk_begin(&walk, node);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (!leaving) continue;
+
+        if (is_foldable(node)) {
+            fold_node(state, node);
+        } else if (is_plus(node)) {
+            // Só o '+' mais externo: o pai (topo do percurso) não
+            // pode continuar a cadeia pela esquerda
+            ASTNode* parent = walk.top > 0 ? walk.frames[walk.top - 1].node : NULL;
+            if (!is_plus(parent) || parent->as.binary.left != node) {
+                gather_concat_chain(arena, node);
+            }
+        }
+    }
+    ast_walk_end(&walk);
+}
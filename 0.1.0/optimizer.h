@@ -0,0 +1,35 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "parser.h"
+#include "evaluator.h"
+
+/********************************************************************
+OTIMIZADOR DA AST - RUDIS
+
+Roda entre parse() e a execução. Subexpressões que só dependem de
+constantes, como (1 + 0.05) ^ 12 ou sqrt(2) * 100, são calculadas uma
+vez e o nó vira NODE_NUMBER/NODE_STRING:
+- operações binárias e unárias com operandos constantes;
+- chamadas de funções puras (builtin_table[id].pure) com todos os
+  argumentos constantes. print, clear e setdec nunca são calculadas.
+
+O cálculo usa o próprio evaluate(), então o resultado é idêntico ao
+da execução. Se ele falhar (5 / 0, sqrt(-1)...) o nó fica como está e
+o erro aparece na execução, no ponto e na ordem originais.
+
+Depois disso, uma cadeia de '+' com texto, como
+    linha = nome + ": " + qtd + " x " + preco
+(((a + b) + c) + d na AST) vira um único NODE_CONCAT com os operandos
+em ordem. Em vez de copiar o lado esquerdo acumulado a cada '+' (k
+operandos custam O(k²) bytes), a execução converte cada operando uma
+vez, aloca o resultado com o tamanho exato e copia tudo em uma
+passada (concatenate_values()). Só cadeias de 3 ou mais operandos com
+uma string literal são juntadas; a + b + c numérico continua como está.
+********************************************************************/
+
+// Dobra as constantes e junta as cadeias de concatenação no lugar
+// (os nós novos e os arrays de operandos ficam na arena do parse)
+void optimize_ast(EvaluatorState* state, Arena* arena, ASTNode* node);
+
+#endif // OPTIMIZER_H
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define stdout_is_terminal() _isatty(_fileno(stdout))
+#else
+#include <unistd.h>
+#define stdout_is_terminal() isatty(STDOUT_FILENO)
+#endif
+
+#include "output.h"
+#include "a89alloc.h"
+
+typedef struct {
+    char data[OUTPUT_BUFFER_SIZE];
+    size_t used;                // Bytes pendentes em data
+    FILE* target;               // stdout ou o arquivo de --output
+    int is_file;                // target foi aberto por output_open_file
+    int flush_each_statement;   // Saída é um terminal
+    int colors;                 // Estilos geram códigos ANSI
+    int failed;                 // Alguma escrita falhou
+    int initialized;
+} OutputBuffer;
+
+static OutputBuffer output;
+
+// NO_COLOR (no-color.org): qualquer valor não vazio desliga as cores
+static int no_color_requested(void) {
+    const char* value = getenv("NO_COLOR");
+    return value != NULL && value[0] != '\0';
+}
+
+void output_init(void) {
+    if (output.initialized) return;
+    output.used = 0;
+    output.target = stdout;
+    output.is_file = 0;
+    output.flush_each_statement = stdout_is_terminal();
+    output.colors = output.flush_each_statement && !no_color_requested();
+    output.failed = 0;
+    output.initialized = 1;
+}
+
+int output_open_file(const char* filename) {
+    FILE* file = fopen(filename, "wb");
+    if (file == NULL) return 0;
+
+    // O buffer já agrupa as escritas: sem o buffer do stdio, cada
+    // gravação vai direto para o arquivo
+    setvbuf(file, NULL, _IONBF, 0);
+
+    output_init();
+    output_flush();
+    output.target = file;
+    output.is_file = 1;
+    output.flush_each_statement = 0;
+    output.colors = 0;
+    return 1;
+}
+
+// Grava length bytes no destino. Em stdout, o que outras partes do
+// programa deixaram no buffer do stdio sai antes (ordem preservada).
+static void write_target(const char* data, size_t length) {
+    if (!output.is_file) fflush(stdout);
+    if (fwrite(data, 1, length, output.target) != length) {
+        output.failed = 1;
+    }
+    if (!output.is_file && fflush(stdout) != 0) {
+        output.failed = 1;
+    }
+}
+
+int output_flush(void) {
+    if (!output.initialized) return 1;
+    if (output.used > 0) {
+        write_target(output.data, output.used);
+        output.used = 0;
+    }
+    return !output.failed;
+}
+
+void output_write(const char* text, size_t length) {
+    if (!output.initialized) output_init();
+
+    if (length > OUTPUT_BUFFER_SIZE - output.used) {
+        output_flush();
+        // Maior que o buffer inteiro: vai direto, sem cópia
+        if (length >= OUTPUT_BUFFER_SIZE) {
+            write_target(text, length);
+            return;
+        }
+    }
+    memcpy(output.data + output.used, text, length);
+    output.used += length;
+}
+
+void output_char(char c) {
+    if (!output.initialized) output_init();
+    if (output.used == OUTPUT_BUFFER_SIZE) output_flush();
+    output.data[output.used++] = c;
+}
+
+void output_string(const char* text) {
+    output_write(text, strlen(text));
+}
+
+void output_printf(const char* format, ...) {
+    if (!output.initialized) output_init();
+
+    va_list args;
+    va_start(args, format);
+    size_t space = OUTPUT_BUFFER_SIZE - output.used;
+    va_list retry;
+    va_copy(retry, args);
+    int length = vsnprintf(output.data + output.used, space, format, args);
+    va_end(args);
+
+    if (length < 0) {
+        va_end(retry);
+        return;
+    }
+    if ((size_t)length < space) {
+        output.used += (size_t)length;
+        va_end(retry);
+        return;
+    }
+
+    // Não coube: esvazia o buffer e formata de novo
+    output_flush();
+    if ((size_t)length < OUTPUT_BUFFER_SIZE) {
+        vsnprintf(output.data, OUTPUT_BUFFER_SIZE, format, retry);
+        output.used = (size_t)length;
+    } else {
+        char* text = A89ALLOC((size_t)length + 1);
+        if (text != NULL) {
+            vsnprintf(text, (size_t)length + 1, format, retry);
+            write_target(text, (size_t)length);
+            a89free(text);
+        } else {
+            output.failed = 1;
+        }
+    }
+    va_end(retry);
+}
+
+void output_statement_end(void) {
+    if (output.flush_each_statement) output_flush();
+}
+
+int output_colors_enabled(void) {
+    if (!output.initialized) output_init();
+    return output.colors;
+}
+
+int output_close(void) {
+    if (!output.initialized) return 1;
+    output_flush();
+    if (output.is_file && fclose(output.target) != 0) {
+        output.failed = 1;
+    }
+    int ok = !output.failed;
+    output.initialized = 0;
+    return ok;
+}
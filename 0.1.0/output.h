@@ -0,0 +1,50 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stddef.h>
+
+/********************************************************************
+SAÍDA BUFERIZADA - RUDIS
+
+Tudo o que o programa imprime (print, resultados do REPL, vars) passa
+por um único buffer de OUTPUT_BUFFER_SIZE bytes, reaproveitado durante
+toda a execução. O buffer é gravado de uma vez:
+- quando enche;
+- ao fim de cada instrução, se a saída é um terminal (o usuário vê
+  cada resultado na hora); em pipes e arquivos só quando enche;
+- antes de pedir entrada (prompt do REPL) e antes de mensagens que
+  ainda usam printf (erros, help, clear), para manter a ordem;
+- em output_close(), no fim do script.
+
+Com --output a saída vai para um arquivo aberto sem buffer do stdio:
+cada gravação do buffer é uma única escrita no arquivo.
+********************************************************************/
+
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+// Começa a escrever em stdout (chamada implícita na primeira escrita)
+void output_init(void);
+
+// Redireciona a saída para um arquivo; retorna 0 se não puder abrir
+int output_open_file(const char* filename);
+
+void output_write(const char* text, size_t length);
+void output_char(char c);
+void output_string(const char* text);
+void output_printf(const char* format, ...);
+
+// Grava o buffer no destino; retorna 0 em caso de erro de escrita
+int output_flush(void);
+
+// Fim de uma instrução: grava o buffer se a saída for um terminal
+void output_statement_end(void);
+
+// 1 se os estilos de red(), bold()... devem gerar códigos ANSI: a saída
+// é um terminal e a variável de ambiente NO_COLOR não está definida
+int output_colors_enabled(void);
+
+// Grava o que falta e fecha o arquivo de --output; retorna 0 se
+// alguma escrita falhou
+int output_close(void);
+
+#endif // OUTPUT_H
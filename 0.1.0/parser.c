@@ -2,57 +2,18 @@
 #include "color.h"
 #include "parser.h"
 #include "a89alloc.h"
-
-// ==================================================================
-// FUNÇÃO AUXILIAR PARA LIBERAR ARGUMENTOS DE FUNÇÃO
-// ==================================================================
-void free_function_args(ASTNode** args, int arg_count) {
-    if (args == NULL) return;
-    
-    for (int i = 0; i < arg_count; i++) {
-        free_ast(args[i]);
-    }
-    a89free(args);
-}
+#include "builtins.h"
 
 // ==================================================================
 // FUNÇÕES DO PARSER
 // ==================================================================
-void parser_save_state(Parser* parser, Parser* saved_state) {
-    // Salva o lexer completo
-    saved_state->lexer->input = parser->lexer->input;
-    saved_state->lexer->input_size = parser->lexer->input_size;
-    saved_state->lexer->position = parser->lexer->position;
-    saved_state->lexer->current_char = parser->lexer->current_char;
-    
-    // Salva o token atual
-    saved_state->current_token = parser->current_token;
-    
-    // Salva estado de erro
-    saved_state->has_error = parser->has_error;
-    strcpy(saved_state->error_message, parser->error_message);
-}
-
-void parser_restore_state(Parser* parser, Parser* saved_state) {
-    // Restaura o lexer
-    parser->lexer->input = saved_state->lexer->input;
-    parser->lexer->input_size = saved_state->lexer->input_size;
-    parser->lexer->position = saved_state->lexer->position;
-    parser->lexer->current_char = saved_state->lexer->current_char;
-    
-    // Restaura o token atual
-    parser->current_token = saved_state->current_token;
-    
-    // Restaura estado de erro
-    parser->has_error = saved_state->has_error;
-    strcpy(parser->error_message, saved_state->error_message);
-}
-
 void parser_init(Parser* parser, Lexer* lexer) {
     parser->lexer = lexer;
     parser->current_token = lexer_get_next_token(lexer);
     parser->has_error = 0;
     strcpy(parser->error_message, "");
+    parser->arena = NULL;
+    parser->stop_at_newline = 0;
 }
 
 void parser_advance(Parser* parser) {
@@ -72,109 +33,15 @@ void parser_set_error(Parser* parser, const char* message) {
 // ==================================================================
 // VALIDACAO DE ARGUMENTOS DE FUNÇÃO
 // ==================================================================
-int validate_function_args(Parser* parser, const char* function_name, int arg_count) {
+int validate_function_args(Parser* parser, int builtin_id, int arg_count) {
     char error_msg[STR_SIZE];
-    
-    // FUNCOES COM 1 ARGUMENTO
-    if (strcmp(function_name, "sqrt") == 0 || 
-        strcmp(function_name, "sin") == 0 ||
-        strcmp(function_name, "cos") == 0 ||
-        strcmp(function_name, "tan") == 0 ||
-        strcmp(function_name, "log") == 0 ||
-        strcmp(function_name, "ln") == 0 ||
-        strcmp(function_name, "exp") == 0 ||
-        strcmp(function_name, "abs") == 0 ||
-        strcmp(function_name, "red") == 0) {
-        if (arg_count != 1) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer exatamente 1 argumento", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires exactly 1 argument", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
-    }
 
-    // FUNCOES COM 2 ARGUMENTOS
-    if (strcmp(function_name, "repeat") == 0){
-        if (arg_count != 2) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer exatamente 2 argumentos", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires exactly 2 arguments", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
+    // Aridade mínima/máxima vem de builtin_table
+    if (!builtin_check_arity(builtin_id, arg_count, error_msg, sizeof(error_msg))) {
+        parser_set_error(parser, error_msg);
+        return 0;
     }
 
-    // FUNCOES COM 3 ARGUMENTOS
-    else if (strcmp(function_name, "pv") == 0 ||
-             strcmp(function_name, "fv") == 0 ||
-             strcmp(function_name, "pmt") == 0 ||
-             strcmp(function_name, "nper") == 0 ||
-             strcmp(function_name, "si") == 0 ||
-             strcmp(function_name, "fv_si") == 0 ||
-             strcmp(function_name, "ci") == 0 ||
-             strcmp(function_name, "fv_ci") == 0 )
-             {
-        if (arg_count != 3) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer exatamente 3 argumentos", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires exactly 3 arguments", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
-    }
-    // FUNCOES COM 4 ARGUMENTOS
-    else if (strcmp(function_name, "rate") == 0) {
-        if (arg_count != 4) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer exatamente 4 argumentos", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires exactly 4 arguments", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
-    }
-    // FUNCOES COM MULTIPLOS ARGUMENTOS (ESTATÍSTICAS)
-    else if (strcmp(function_name, "mean") == 0 || 
-             strcmp(function_name, "median") == 0 ||
-             strcmp(function_name, "std") == 0 ||
-             strcmp(function_name, "sum") == 0 ||
-             strcmp(function_name, "min") == 0 ||
-             strcmp(function_name, "max") == 0 ||
-             // NOVAS FUNÇÕES ESTATÍSTICAS
-             strcmp(function_name, "variance") == 0 ||
-             strcmp(function_name, "mode") == 0 ){
-        if (arg_count < 1) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer pelo menos 1 argumento", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires at least 1 argument", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
-    }
-    // FUNÇÕES FINANCEIRAS
-    else if (strcmp(function_name, "npv") == 0 ||
-             strcmp(function_name, "irr") == 0 ) {
-        if (arg_count < 2) {
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg), "Função %s requer pelo menos 2 argumentos", function_name);
-            } else {
-                snprintf(error_msg, sizeof(error_msg), "Function %s requires at least 2 arguments", function_name);
-            }
-            parser_set_error(parser, error_msg);
-            return 0;
-        }
-    }
-    
     return 1;
 }
 
@@ -182,235 +49,210 @@ int validate_function_args(Parser* parser, const char* function_name, int arg_co
 // ==================================================================
 // CRIACAO DE NOS DA AST
 // ==================================================================
-ASTNode* create_number_node(double value) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
+/*
+ * Aloca um nó com 'size' bytes (AST_NODE_SIZE do tipo) na arena. Só o
+ * cabeçalho é preenchido; cada create_* preenche o seu membro de 'as'.
+ */
+static ASTNode* node_alloc(Arena* arena, size_t size, NodeType type, const char* what) {
+    ASTNode* node = arena_alloc(arena, size);
     if (!node) {
-        printf("Erro ao alocar memória para number_node: %.2f\n", value);
+        printf("Erro ao alocar memória para %s\n", what);
         exit(EXIT_FAILURE);
     }
-    node->type = NODE_NUMBER;
-
-    node->value = create_number_value(value);
-    node->text[0] = '\0';
-    node->operator = '\0';  
-    node->function[0] = '\0';
-
-    node->left = node->right = node->operand = NULL;
-
-    node->args = NULL;
-    node->arg_count = 0;
-
-    node->statements = NULL;
-    node->stmt_count = 0;
-
+    node->type = (unsigned char)type;
+    node->operator = '\0';
+    node->position = -1;
     return node;
 }
 
-ASTNode* create_variable_node(const char* variable) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para variable_node: %s\n", variable);
+// Copia o nome de uma variável para a arena
+static const char* arena_copy_name(Arena* arena, const char* name) {
+    size_t length = strlen(name);
+    char* copy = arena_alloc(arena, length + 1);
+    if (!copy) {
+        printf("Erro ao alocar memória para o nome: %s\n", name);
         exit(EXIT_FAILURE);
     }
-    node->type = NODE_VARIABLE;
-
-    node->value = create_null_value();
-    strncpy(node->text, variable, sizeof(node->text) - 1);
-    node->text[sizeof(node->text) - 1] = '\0';
-    node->operator = '\0';  
-    node->function[0] = '\0';
-
-    node->left = node->right = node->operand = NULL;
-
-    node->args = NULL;
-    node->arg_count = 0;
+    memcpy(copy, name, length + 1);
+    return copy;
+}
 
-    node->statements = NULL;
-    node->stmt_count = 0;
+ASTNode* create_number_node(Arena* arena, double value) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(value), NODE_NUMBER, "number_node");
+    node->as.value = create_number_value(value);
+    return node;
+}
 
+ASTNode* create_integer_node(Arena* arena, int64_t value) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(value), NODE_NUMBER, "number_node");
+    node->as.value = create_integer_value(value);
     return node;
 }
 
-ASTNode* create_binary_op_node(char operator, ASTNode* left, ASTNode* right) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para binary_op_node: %c\n", operator);
-        exit(EXIT_FAILURE);
-    }
-    node->type = NODE_BINARY_OP;
+ASTNode* create_variable_node(Arena* arena, const char* variable) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(variable), NODE_VARIABLE, "variable_node");
+    node->as.variable.name = arena_copy_name(arena, variable);
+    node->as.variable.slot = -1;
+    node->as.variable.value = NULL;
+    return node;
+}
 
-    node->value = create_null_value();
-    node->text[0] = '\0';
+ASTNode* create_binary_op_node(Arena* arena, char operator, ASTNode* left, ASTNode* right) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(binary), NODE_BINARY_OP, "binary_op_node");
     node->operator = operator;
-    node->function[0] = '\0';
-
-    node->left = left;
-    node->right = right;
-    node->operand = NULL;
-
-    node->args = NULL;
-    node->arg_count = 0;
-
-    node->statements = NULL;
-    node->stmt_count = 0;
-
+    node->as.binary.left = left;
+    node->as.binary.right = right;
     return node;
 }
 
-ASTNode* create_unary_op_node(char operator, ASTNode* operand) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para unary_op_node: %c\n", operator);
-        exit(EXIT_FAILURE);
-    }
-    node->type = NODE_UNARY_OP;
-
-    node->value = create_null_value();
-    node->text[0] = '\0';
+ASTNode* create_unary_op_node(Arena* arena, char operator, ASTNode* operand) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(unary), NODE_UNARY_OP, "unary_op_node");
     node->operator = operator;
-    node->function[0] = '\0';
-
-    node->left = node->right = NULL;
-    node->operand = operand;
-
-    node->args = NULL;
-    node->arg_count = 0;
-
-    node->statements = NULL;
-    node->stmt_count = 0;
-
+    node->as.unary.operand = operand;
     return node;
 }
 
-ASTNode* create_function_node(const char* function, ASTNode** args, int arg_count) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para function_node: %s\n", function);
-        exit(EXIT_FAILURE);
-    }
-    node->type = NODE_FUNCTION;
-
-    node->value = create_null_value();
-    node->text[0] = '\0';
-    node->operator = '\0';    
-    strncpy(node->function, function, sizeof(node->function) - 1);
-    node->function[sizeof(node->function) - 1] = '\0';
-    
-    node->left = node->right = node->operand = NULL;
-
-    node->args = args;
-    node->arg_count = arg_count;
-
-    node->statements = NULL;
-    node->stmt_count = 0;
-
+ASTNode* create_function_node(Arena* arena, int builtin_id, ASTNode** args, int arg_count) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(call), NODE_FUNCTION, "function_node");
+    node->as.call.args = args;
+    node->as.call.arg_count = arg_count;
+    node->as.call.builtin_id = builtin_id;
     return node;
 }
 
-ASTNode* create_assignment_node(const char* variable, ASTNode* expr_value) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para assignment_node: %s\n", variable);
-        exit(EXIT_FAILURE);
-    }
-    node->type = NODE_ASSIGNMENT;
-
-    node->value = create_null_value();
-    strncpy(node->text, variable, sizeof(node->text) - 1);
-    node->text[sizeof(node->text) - 1] = '\0';
-    node->operator = '\0';  
-    node->function[0] = '\0';
-
-    node->right = expr_value;
-    node->left = node->operand = NULL;
-
-    node->args = NULL;
-    node->arg_count = 0;
-
-    node->statements = NULL;
-    node->stmt_count = 0;
-
+ASTNode* create_assignment_node(Arena* arena, const char* variable, ASTNode* expr_value) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(variable), NODE_ASSIGNMENT, "assignment_node");
+    node->as.variable.name = arena_copy_name(arena, variable);
+    node->as.variable.slot = -1;
+    node->as.variable.value = expr_value;
     return node;
 }
 
-ASTNode* create_string_node(const char* str_value) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para string_node: %s\n", str_value);
-        exit(EXIT_FAILURE);
-    }
-    node->type = NODE_STRING;
-
-    node->value = create_string_value(str_value);
-    node->text[0] = '\0';  
-    node->operator = '\0';  
-    node->function[0] = '\0';
+ASTNode* create_string_node(Arena* arena, Value str_value) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(value), NODE_STRING, "string_node");
+    node->as.value = str_value;
+    return node;
+}
 
-    node->left = node->right = node->operand = NULL;
+ASTNode* create_sequence_node(Arena* arena, ASTNode** statements, int stmt_count) {
+    ASTNode* node = node_alloc(arena, AST_NODE_SIZE(sequence), NODE_SEQUENCE, "sequence_node");
+    node->as.sequence.statements = statements;
+    node->as.sequence.count = stmt_count;
+    return node;
+}
 
-    node->args = NULL;
-    node->arg_count = 0;
+/*
+ * Os nós, os arrays de argumentos e de statements pertencem à arena do
+ * parse e são liberados em bloco por arena_reset(). Aqui só são
+ * liberados os valores (strings) guardados nos nós.
+ */
+void free_ast(ASTNode* node) {
+    ASTWalk walk;
+    int leaving;
 
-    node->statements = NULL;
-    node->stmt_count = 0;
+    ast_walk_begin(&walk, node);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (leaving && (node->type == NODE_NUMBER || node->type == NODE_STRING)) {
+            value_release(&node->as.value);
+        }
+    }
+    ast_walk_end(&walk);
+}
 
-    return node;
+// ==================================================================
+// PERCURSO DA AST SEM RECURSÃO
+// ==================================================================
+int ast_child_count(const ASTNode* node) {
+    switch (node->type) {
+        case NODE_ASSIGNMENT: return 1;
+        case NODE_BINARY_OP:  return 2;
+        case NODE_CONCAT:     return node->as.concat.count;
+        case NODE_UNARY_OP:   return 1;
+        case NODE_FUNCTION:   return node->as.call.arg_count;
+        case NODE_SEQUENCE:   return node->as.sequence.count;
+        default:              return 0;
+    }
 }
 
-ASTNode* create_sequence_node(ASTNode** statements, int stmt_count) {
-    ASTNode* node = A89ALLOC(sizeof(ASTNode));
-    if (!node) {
-        printf("Erro ao alocar memória para sequence_node\n");
-        exit(EXIT_FAILURE);
+ASTNode* ast_child(const ASTNode* node, int index) {
+    switch (node->type) {
+        case NODE_ASSIGNMENT: return node->as.variable.value;
+        case NODE_BINARY_OP:  return index == 0 ? node->as.binary.left : node->as.binary.right;
+        case NODE_CONCAT:     return node->as.concat.parts[index];
+        case NODE_UNARY_OP:   return node->as.unary.operand;
+        case NODE_FUNCTION:   return node->as.call.args[index];
+        case NODE_SEQUENCE:   return node->as.sequence.statements[index];
+        default:              return NULL;
     }
-    node->type = NODE_SEQUENCE;
+}
 
-    node->value = create_null_value();
-    node->text[0] = '\0';
-    node->operator = '\0';  
-    node->function[0] = '\0';
+void ast_walk_begin(ASTWalk* walk, ASTNode* root) {
+    walk->frames = walk->inline_frames;
+    walk->capacity = AST_WALK_INLINE;
+    walk->error = AST_WALK_OK;
+    walk->top = 0;
+    if (root != NULL) {
+        walk->frames[0].node = root;
+        walk->frames[0].next_child = -1;
+        walk->top = 1;
+    }
+}
 
-    node->left = NULL;
-    node->right = NULL;
-    node->operand = NULL;    
+// Dobra a pilha do percurso (a primeira vez sai do vetor inline)
+static int ast_walk_grow(ASTWalk* walk) {
+    int new_capacity = walk->capacity * 2;
+    ASTWalkFrame* new_frames = (ASTWalkFrame*)A89ALLOC(new_capacity * sizeof(ASTWalkFrame));
+    if (!new_frames) return 0;
+    memcpy(new_frames, walk->frames, walk->top * sizeof(ASTWalkFrame));
+    if (walk->frames != walk->inline_frames) {
+        a89free(walk->frames);
+    }
+    walk->frames = new_frames;
+    walk->capacity = new_capacity;
+    return 1;
+}
 
-    node->args = NULL;
-    node->arg_count = 0;
+ASTNode* ast_walk_next(ASTWalk* walk, int* leaving) {
+    while (walk->top > 0) {
+        ASTWalkFrame* frame = &walk->frames[walk->top - 1];
+        ASTNode* node = frame->node;
 
-    node->statements = statements;
-    node->stmt_count = stmt_count;
-    
-    return node;
-}
+        if (frame->next_child < 0) {
+            frame->next_child = 0;
+            frame->child_count = ast_child_count(node);
+            *leaving = 0;
+            return node;
+        }
 
-void free_ast(ASTNode* node) {
-    if (node == NULL) return;
+        if (frame->next_child >= frame->child_count) {
+            walk->top--;
+            *leaving = 1;
+            return node;
+        }
 
-    if (node->type == NODE_SEQUENCE) {
-        // Liberar todos os statements
-        if (node->statements != NULL) {
-            for (int i = 0; i < node->stmt_count; i++) {
-                free_ast(node->statements[i]);
-            }
-            a89free(node->statements);
+        ASTNode* child = ast_child(node, frame->next_child++);
+        if (child == NULL) {
+            walk->error = AST_WALK_NULL_CHILD;
+            break;
         }
-        // Depois liberar o próprio nó
-        a89free(node);
-        return;  // IMPORTANTE: retornar aqui para não processar duas vezes
-    }
-    
-    free_ast(node->left);
-    free_ast(node->right);
-    free_ast(node->operand);
-    
-    if (node->args != NULL) {
-        for (int i = 0; i < node->arg_count; i++) {
-            free_ast(node->args[i]);
+        if (walk->top == walk->capacity && !ast_walk_grow(walk)) {
+            walk->error = AST_WALK_NO_MEMORY;
+            break;
         }
-        a89free(node->args);
+        walk->frames[walk->top].node = child;
+        walk->frames[walk->top].next_child = -1;
+        walk->top++;
     }
-    
-    a89free(node);
+    walk->top = 0;
+    return NULL;
+}
+
+void ast_walk_end(ASTWalk* walk) {
+    if (walk->frames != walk->inline_frames) {
+        a89free(walk->frames);
+    }
+    walk->frames = walk->inline_frames;
+    walk->top = 0;
 }
 
 /********************************************************************
@@ -420,13 +262,17 @@ GRAMATICA v0.0.2
 program          := statement_list
 statement_list   := statement ((';' | NEWLINE) statement)*
 statement        := expression
-expression       := assignment | arithmetic_expr
+expression       := assignment | bit_or_expr
 assignment       := IDENTIFIER '=' expression
+bit_or_expr      := bit_xor_expr ('|' bit_xor_expr)*
+bit_xor_expr     := bit_and_expr ('~' bit_and_expr)*
+bit_and_expr     := shift_expr ('&' shift_expr)*
+shift_expr       := arithmetic_expr (('<<' | '>>') arithmetic_expr)*
 arithmetic_expr  := term (('+' | '-') term)*
 term             := factor (('*' | '/' | '%') factor)*
 factor           := power ('!')?
 power            := atom ('^' power)?
-atom             := NUMBER | STRING | IDENTIFIER | function_call | '(' expression ')' | '-' atom
+atom             := NUMBER | STRING | IDENTIFIER | function_call | '(' expression ')' | ('-' | '~') atom
 function_call    := FUNCTION '(' argument_list ')'
 argument_list    := expression (',' expression)*
 ********************************************************************/
@@ -462,7 +308,7 @@ ASTNode* parse_statement_list(Parser* parser) {
     
     // Alocar array inicial (tamanho 4)
     capacity = 4;
-    statements = (ASTNode**)A89ALLOC(sizeof(ASTNode*) * capacity);
+    statements = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
     if (!statements) {
         free_ast(first_stmt);
         parser_set_error(parser, "Falha de alocação de memória para statements");
@@ -477,13 +323,19 @@ ASTNode* parse_statement_list(Parser* parser) {
         Token current = parser->current_token;
         
         // Verificar se há separador de statements
-        if (current.type == TOKEN_SEMICOLON || current.type == TOKEN_NEWLINE) {
+        if (current.type == TOKEN_SEMICOLON || 
+            (current.type == TOKEN_NEWLINE && !parser->stop_at_newline)) {
             parser_advance(parser);  // Consumir ';' ou NEWLINE
             
             // Se encontramos EOF após separador, terminar
             if (parser->current_token.type == TOKEN_EOF) {
                 break;
             }
+
+            // Linha terminada em ';' (modo linha a linha)
+            if (parser->current_token.type == TOKEN_NEWLINE && parser->stop_at_newline) {
+                break;
+            }
             
             // Parse próximo statement
             ASTNode* next_stmt = parse_statement(parser);
@@ -494,7 +346,6 @@ ASTNode* parse_statement_list(Parser* parser) {
                     for (int i = 0; i < count; i++) {
                         free_ast(statements[i]);
                     }
-                    a89free(statements);
                     return NULL;
                 }
                 // Statement vazio, continuar
@@ -504,23 +355,21 @@ ASTNode* parse_statement_list(Parser* parser) {
             // Expandir array se necessário
             if (count >= capacity) {
                 capacity *= 2;
-                ASTNode** new_statements = (ASTNode**)A89ALLOC(sizeof(ASTNode*) * capacity);
+                ASTNode** new_statements = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
                 if (!new_statements) {
                     // Liberar tudo em caso de erro de alocação
                     for (int i = 0; i < count; i++) {
                         free_ast(statements[i]);
                     }
                     free_ast(next_stmt);
-                    a89free(statements);
                     parser_set_error(parser, "Falha de alocação de memória para new_statements.");
                     return NULL;
                 }
                 
-                // Copiar statements antigos
+                // Copiar statements antigos (o array antigo fica na arena)
                 for (int i = 0; i < count; i++) {
                     new_statements[i] = statements[i];
                 }
-                a89free(statements);
                 statements = new_statements;
             }
             
@@ -535,19 +384,56 @@ ASTNode* parse_statement_list(Parser* parser) {
     // Casos especiais:
     if (count == 0) {
         // Nenhum statement (programa vazio)
-        a89free(statements);
-        return create_sequence_node(NULL, 0);
+        return create_sequence_node(parser->arena, NULL, 0);
     }
     
     if (count == 1) {
         // Apenas um statement - retornar diretamente sem criar sequence node
-        ASTNode* single_stmt = statements[0];
-        a89free(statements);  // Liberar array, mas manter o statement
-        return single_stmt;
+        return statements[0];
     }
     
     // Múltiplos statements - criar nó de sequência
-    return create_sequence_node(statements, count);
+    ASTNode* sequence = create_sequence_node(parser->arena, statements, count);
+    sequence->position = statements[0]->position;
+    return sequence;
+}
+
+//===================================================================
+// Lê a próxima linha lógica de um script: statements separados por
+// ';' até um NEWLINE (ou EOF). Linhas vazias são puladas.
+// Retorna NULL no fim da entrada ou em caso de erro (has_error).
+//===================================================================
+ASTNode* parse_line(Parser* parser) {
+    while (parser->current_token.type == TOKEN_NEWLINE ||
+           parser->current_token.type == TOKEN_SEMICOLON) {
+        parser_advance(parser);
+    }
+
+    if (parser->current_token.type == TOKEN_EOF) {
+        return NULL;
+    }
+
+    parser->stop_at_newline = 1;
+    ASTNode* result = parse_statement_list(parser);
+    parser->stop_at_newline = 0;
+
+    if (parser->has_error) {
+        if (result != NULL) {
+            free_ast(result);
+        }
+        return NULL;
+    }
+
+    if (parser->current_token.type != TOKEN_NEWLINE &&
+        parser->current_token.type != TOKEN_EOF) {
+        if (result != NULL) {
+            free_ast(result);
+        }
+        parser_set_error(parser, get_error_incomplete_expression());
+        return NULL;
+    }
+
+    return result;
 }
 
 //===================================================================
@@ -559,255 +445,423 @@ ASTNode* parse_statement(Parser* parser) {
 
 //===================================================================
 // expression := assignment | arithmetic_expr
+//
+// Precedência de operadores (Pratt) com pilhas explícitas: os operandos
+// prontos ficam em uma pilha de nós e os operadores ainda sem o operando
+// da direita em outra. Um operador novo primeiro reduz os da pilha que
+// ligam mais forte do que ele. Parênteses, chamadas de função e
+// atribuições empilham um quadro, que separa os operadores de dentro dos
+// de fora; o fim da expressão interna fecha o quadro.
 //===================================================================
-ASTNode* parse_expression(Parser* parser) {
-    // Salva estado atual para possivel rollback
-    Parser saved_state;
-    Lexer saved_lexer;
-    saved_state.lexer = &saved_lexer;
-    parser_save_state(parser, &saved_state);
-    
-    // Tenta parsear como atribuicao
-    if (parser->current_token.type == TOKEN_IDENTIFIER) { 
-        char variable[STR_SIZE];
-        strncpy(variable, parser->current_token.text, sizeof(variable) - 1);
-        variable[sizeof(variable) - 1] = '\0';
-
-        // Verifica se é palavra reservada (não pode ser variável)
-        if (is_reserved_word(variable)) {
-            char error_msg[STR_SIZE];
-            if (current_lang == LANG_PT) {
-                snprintf(error_msg, sizeof(error_msg),
-                         "Não pode usar '%s' como nome de variável (é palavra reservada)",
-                         variable);
-            } else {
-                snprintf(error_msg, sizeof(error_msg),
-                         "Cannot use '%s' as variable name (is a reserved word)",
-                         variable);
-            }
-            parser_set_error(parser, error_msg);
-            return NULL;
-        }
+#define PARSE_INLINE_STACK 32
+
+// Força de ligação dos operadores
+#define BINDING_BIT_OR           4  // |
+#define BINDING_BIT_XOR          5  // ~ (binário)
+#define BINDING_BIT_AND          6  // &
+#define BINDING_SHIFT            8  // << >>
+#define BINDING_ADDITIVE        10  // + -
+#define BINDING_MULTIPLICATIVE  20  // * / %
+#define BINDING_FACTORIAL       30  // ! (pós-fixo)
+#define BINDING_POWER           40  // ^ (associativo à direita)
+#define BINDING_PREFIX          50  // - ~ (prefixo, só sobre o atom)
+
+typedef enum {
+    PARSE_PREFIX,       // Operador prefixo esperando o operando
+    PARSE_INFIX,        // Operador binário esperando o operando da direita
+    PARSE_GROUP,        // '(' expression ')'
+    PARSE_CALL,         // FUNCTION '(' argument_list ')'
+    PARSE_ASSIGN        // IDENTIFIER '=' expression
+} ParseOpKind;
+
+typedef struct {
+    ParseOpKind kind;
+    char operator;
+    int binding;
+    int position;
+    int builtin_id;     // PARSE_CALL
+    int operand_base;   // PARSE_CALL: índice do primeiro argumento na pilha de operandos
+    ASTNode* target;    // PARSE_ASSIGN: nó da variável atribuída
+} ParseOp;
+
+typedef struct {
+    ASTNode** operands;
+    int operand_count;
+    int operand_capacity;
+    ParseOp* ops;
+    int op_count;
+    int op_capacity;
+    ASTNode* inline_operands[PARSE_INLINE_STACK];
+    ParseOp inline_ops[PARSE_INLINE_STACK];
+} ParseStacks;
+
+static void parse_stacks_init(ParseStacks* stacks) {
+    stacks->operands = stacks->inline_operands;
+    stacks->operand_count = 0;
+    stacks->operand_capacity = PARSE_INLINE_STACK;
+    stacks->ops = stacks->inline_ops;
+    stacks->op_count = 0;
+    stacks->op_capacity = PARSE_INLINE_STACK;
+}
 
-        parser_advance(parser);
-        
-        if (parser->current_token.type == TOKEN_ASSIGN) {
-            // É uma atribuicao valida
-            parser_advance(parser);
-            ASTNode* value = parse_expression(parser);
-            if (parser->has_error) return NULL;
-            return create_assignment_node(variable, value);
-        }
+// Libera os vetores alocados e os valores dos nós que sobraram (erro)
+static void parse_stacks_free(ParseStacks* stacks) {
+    for (int i = 0; i < stacks->operand_count; i++) {
+        free_ast(stacks->operands[i]);
     }
-    
-    // Se não é atribuição, restaura estado e parse como expressão aritmética
-    parser_restore_state(parser, &saved_state);
-    return parse_arithmetic_expr(parser);
+    if (stacks->operands != stacks->inline_operands) a89free(stacks->operands);
+    if (stacks->ops != stacks->inline_ops) a89free(stacks->ops);
 }
 
-//===================================================================
-// arithmetic_expr := term (('+' | '-') term)*
-//===================================================================
-ASTNode* parse_arithmetic_expr(Parser* parser) {
-    ASTNode* node = parse_term(parser);
-    if (parser->has_error) return NULL;
-    
-    while (parser->current_token.type == TOKEN_OPERATOR &&
-           (parser->current_token.operator == '+' ||
-            parser->current_token.operator == '-')) {
-        char op = parser->current_token.operator;
-        parser_advance(parser);
-        ASTNode* right = parse_term(parser);
-        if (parser->has_error) {
+// Dobra um vetor da pilha (a primeira vez sai do vetor inline)
+static void* parse_stack_grow(void* items, void* inline_items, int* capacity, size_t item_size) {
+    void* grown = A89ALLOC((size_t)*capacity * 2 * item_size);
+    if (!grown) return NULL;
+    memcpy(grown, items, (size_t)*capacity * item_size);
+    if (items != inline_items) a89free(items);
+    *capacity *= 2;
+    return grown;
+}
+
+static int push_operand(Parser* parser, ParseStacks* stacks, ASTNode* node) {
+    if (stacks->operand_count == stacks->operand_capacity) {
+        ASTNode** grown = parse_stack_grow(stacks->operands, stacks->inline_operands,
+                                           &stacks->operand_capacity, sizeof(ASTNode*));
+        if (!grown) {
             free_ast(node);
-            return NULL;
+            parser_set_error(parser, "Falha de alocação de memória para a pilha de operandos");
+            return 0;
         }
-        node = create_binary_op_node(op, node, right);
+        stacks->operands = grown;
     }
-    
-    return node;
+    stacks->operands[stacks->operand_count++] = node;
+    return 1;
 }
 
-//===================================================================
-// term := factor (('*' | '/' | '%') factor)*
-//===================================================================
-ASTNode* parse_term(Parser* parser) {
-    ASTNode* node = parse_factor(parser);
-    if (parser->has_error) return NULL;
-    
-    while (parser->current_token.type == TOKEN_OPERATOR &&
-           (parser->current_token.operator == '*' || 
-            parser->current_token.operator == '/' || 
-            parser->current_token.operator == '%')) {
-        char op = parser->current_token.operator;
-        parser_advance(parser);
-        ASTNode* right = parse_factor(parser);
-        if (parser->has_error) {
-            free_ast(node);
+static ParseOp* push_op(Parser* parser, ParseStacks* stacks, ParseOpKind kind, int position) {
+    if (stacks->op_count == stacks->op_capacity) {
+        ParseOp* grown = parse_stack_grow(stacks->ops, stacks->inline_ops,
+                                          &stacks->op_capacity, sizeof(ParseOp));
+        if (!grown) {
+            parser_set_error(parser, "Falha de alocação de memória para a pilha de operadores");
             return NULL;
         }
-        node = create_binary_op_node(op, node, right);
+        stacks->ops = grown;
+    }
+    ParseOp* op = &stacks->ops[stacks->op_count++];
+    op->kind = kind;
+    op->operator = '\0';
+    op->binding = 0;
+    op->position = position;
+    op->builtin_id = -1;
+    op->operand_base = stacks->operand_count;
+    op->target = NULL;
+    return op;
+}
+
+static int is_operator_op(const ParseOp* op) {
+    return op->kind == PARSE_PREFIX || op->kind == PARSE_INFIX;
+}
+
+/*
+ * Reduz os operadores do topo (até o quadro mais próximo) que ligam
+ * mais forte do que 'binding'; com empate, só reduz se o operador novo
+ * for associativo à esquerda. binding = 0 reduz todos.
+ */
+static void reduce_operators(Parser* parser, ParseStacks* stacks, int binding, int right_assoc) {
+    while (stacks->op_count > 0) {
+        ParseOp* op = &stacks->ops[stacks->op_count - 1];
+        if (!is_operator_op(op)) break;
+        if (op->binding < binding || (op->binding == binding && right_assoc)) break;
+
+        ASTNode* node;
+        if (op->kind == PARSE_PREFIX) {
+            ASTNode* operand = stacks->operands[--stacks->operand_count];
+            node = create_unary_op_node(parser->arena, op->operator, operand);
+        } else {
+            ASTNode* right = stacks->operands[--stacks->operand_count];
+            ASTNode* left = stacks->operands[--stacks->operand_count];
+            node = create_binary_op_node(parser->arena, op->operator, left, right);
+        }
+        node->position = op->position;
+        stacks->operands[stacks->operand_count++] = node;
+        stacks->op_count--;
     }
-    
-    return node;
 }
 
-//===================================================================
-// factor := power ('!')?
-//===================================================================
-ASTNode* parse_factor(Parser* parser) {
-    ASTNode* node = parse_power(parser);
-    if (parser->has_error) return NULL;
-    
-    if (parser->current_token.type == TOKEN_OPERATOR &&
-        parser->current_token.operator == '!') {
-        char op = parser->current_token.operator;
-        parser_advance(parser);
-        node = create_unary_op_node(op, node);
+static int binary_binding(char operator) {
+    switch (operator) {
+        case '+': case '-':           return BINDING_ADDITIVE;
+        case '*': case '/': case '%': return BINDING_MULTIPLICATIVE;
+        case '^':                     return BINDING_POWER;
+        case '&':                     return BINDING_BIT_AND;
+        case '|':                     return BINDING_BIT_OR;
+        case '~':                     return BINDING_BIT_XOR;
+        case '<': case '>':           return BINDING_SHIFT;
+        default:                      return 0;
     }
-    
-    return node;
 }
 
-//===================================================================
-// power := atom ('^' power)?
-//===================================================================
-ASTNode* parse_power(Parser* parser) {
-    ASTNode* node = parse_atom(parser);
-    if (parser->has_error) return NULL;
-    
-    if (parser->current_token.type == TOKEN_OPERATOR &&
-        parser->current_token.operator == '^') {
-        char op = parser->current_token.operator;
-        parser_advance(parser);
-        ASTNode* right = parse_power(parser);
-        if (parser->has_error) {
-            free_ast(node);
-            return NULL;
+// Fecha a chamada do quadro do topo: os argumentos saem da pilha de
+// operandos para um array na arena do tamanho exato (uma única cópia)
+static int close_call(Parser* parser, ParseStacks* stacks) {
+    ParseOp* frame = &stacks->ops[stacks->op_count - 1];
+    int arg_count = stacks->operand_count - frame->operand_base;
+
+    if (!validate_function_args(parser, frame->builtin_id, arg_count)) {
+        return 0;
+    }
+
+    if (!parser_expect(parser, TOKEN_RPAREN)) {
+        parser_set_error(parser, get_error_expected_rparen_after_args());
+        return 0;
+    }
+    parser_advance(parser);
+
+    ASTNode** args = NULL;
+    if (arg_count > 0) {
+        args = arena_alloc(parser->arena, arg_count * sizeof(ASTNode*));
+        if (!args) {
+            parser_set_error(parser, "Falha de alocação de memória para os argumentos");
+            return 0;
         }
-        node = create_binary_op_node(op, node, right);
+        memcpy(args, stacks->operands + frame->operand_base, arg_count * sizeof(ASTNode*));
     }
-    
-    return node;
+    stacks->operand_count = frame->operand_base;
+
+    ASTNode* call = create_function_node(parser->arena, frame->builtin_id, args, arg_count);
+    call->position = frame->position;
+    stacks->op_count--;
+    return push_operand(parser, stacks, call);
 }
 
-//===================================================================
-// atom := NUMBER | STRING | IDENTIFIER | function_call | '(' expression ')' | '-' atom
-//===================================================================
-ASTNode* parse_atom(Parser* parser) {
-    Token token = parser->current_token;
+ASTNode* parse_expression(Parser* parser) {
+    ParseStacks stacks;
+    ASTNode* result = NULL;
+    char name[STR_SIZE];
+
+    int expect_operand = 1;     // Próximo token deve iniciar um operando
+    int expression_start = 1;   // O operando inicia uma expression
+    int assignable = 0;         // Operando do topo é um IDENTIFIER sozinho no início da expression
+    int after_factorial = 0;    // Último operador foi '!': não aceita '^' nem outro '!'
+
+    parse_stacks_init(&stacks);
+
+    while (!parser->has_error) {
+        Token token = parser->current_token;
+
+        if (expect_operand) {
+            int starts_expression = expression_start;
+            expression_start = 0;
+            assignable = 0;
+            after_factorial = 0;
+
+            switch (token.type) {
+                case TOKEN_NUMBER:
+                    {
+                        parser_advance(parser);
+                        ASTNode* number = token.is_integer
+                            ? create_integer_node(parser->arena, token.integer)
+                            : create_number_node(parser->arena, token.value);
+                        number->position = token.position;
+                        if (push_operand(parser, &stacks, number)) expect_operand = 0;
+                    }
+                    break;
+
+                case TOKEN_STRING:
+                    {
+                        parser_advance(parser);
+                        ASTNode* string = create_string_node(parser->arena,
+                                                             lexer_string_value(parser->lexer, &token));
+                        string->position = token.position;
+                        if (push_operand(parser, &stacks, string)) expect_operand = 0;
+                    }
+                    break;
+
+                case TOKEN_IDENTIFIER:
+                    {
+                        token_copy_text(parser->lexer, &token, name, sizeof(name));
+
+                        // Verifica se é palavra reservada (não pode ser variável)
+                        if (starts_expression && is_reserved_word(name)) {
+                            char error_msg[STR_SIZE];
+                            if (current_lang == LANG_PT) {
+                                snprintf(error_msg, sizeof(error_msg),
+                                         "Não pode usar '%s' como nome de variável (é palavra reservada)",
+                                         name);
+                            } else {
+                                snprintf(error_msg, sizeof(error_msg),
+                                         "Cannot use '%s' as variable name (is a reserved word)",
+                                         name);
+                            }
+                            parser_set_error(parser, error_msg);
+                            break;
+                        }
+
+                        parser_advance(parser);
+                        ASTNode* variable = create_variable_node(parser->arena, name);
+                        variable->position = token.position;
+                        if (push_operand(parser, &stacks, variable)) {
+                            expect_operand = 0;
+                            assignable = starts_expression;
+                        }
+                    }
+                    break;
+
+                case TOKEN_FUNCTION:
+                    {
+                        parser_advance(parser);
+                        if (!parser_expect(parser, TOKEN_LPAREN)) {
+                            parser_set_error(parser, get_error_expected_lparen_after_func());
+                            break;
+                        }
+                        parser_advance(parser);
+
+                        ParseOp* call = push_op(parser, &stacks, PARSE_CALL, token.position);
+                        if (!call) break;
+                        call->builtin_id = token.builtin_id;
+
+                        if (parser_expect(parser, TOKEN_RPAREN)) {
+                            if (close_call(parser, &stacks)) expect_operand = 0;
+                        } else {
+                            expression_start = 1;
+                        }
+                    }
+                    break;
 
-    switch (token.type) {
-        case TOKEN_NUMBER:
-            parser_advance(parser);
-            return create_number_node(token.value);
+                case TOKEN_LPAREN:
+                    parser_advance(parser);
+                    if (push_op(parser, &stacks, PARSE_GROUP, token.position)) {
+                        expression_start = 1;
+                    }
+                    break;
+
+                case TOKEN_OPERATOR:
+                    if (token.operator == '-' || token.operator == '~') {
+                        parser_advance(parser);
+                        ParseOp* prefix = push_op(parser, &stacks, PARSE_PREFIX, token.position);
+                        if (prefix) {
+                            prefix->operator = token.operator;
+                            prefix->binding = BINDING_PREFIX;
+                        }
+                    } else {
+                        parser_set_error(parser, get_error_invalid_expression());
+                    }
+                    break;
 
-        case TOKEN_STRING:   
-            parser_advance(parser);
-            return create_string_node(token.text);
-                    
-        case TOKEN_IDENTIFIER:
-            parser_advance(parser);
-            return create_variable_node(token.text);
-            
-        case TOKEN_FUNCTION:
-            return parse_function_call(parser, token.text);
-            
-        case TOKEN_LPAREN:
-            parser_advance(parser);
-            ASTNode* node = parse_expression(parser);
-            if (parser->has_error) return NULL;
-            
-            if (!parser_expect(parser, TOKEN_RPAREN)) {
-                free_ast(node);
-                parser_set_error(parser, get_error_expected_rparen());
-                return NULL;
+                case TOKEN_ERROR:
+                    parser_set_error(parser, parser->lexer->error_message);
+                    break;
+
+                default:
+                    parser_set_error(parser, get_error_invalid_expression());
+                    break;
             }
+            continue;
+        }
+
+        // Operador binário: reduz os que ligam mais forte e empilha
+        if (token.type == TOKEN_OPERATOR && binary_binding(token.operator) != 0 &&
+            !(after_factorial && token.operator == '^')) {
+            int binding = binary_binding(token.operator);
+            int right_assoc = (token.operator == '^');
+            reduce_operators(parser, &stacks, binding, right_assoc);
+
             parser_advance(parser);
-            return node;
-            
-        case TOKEN_OPERATOR:
-            if (token.operator == '-') {
-                parser_advance(parser);
-                ASTNode* operand = parse_atom(parser);
-                if (parser->has_error) return NULL;
-                return create_unary_op_node('-', operand);
+            ParseOp* infix = push_op(parser, &stacks, PARSE_INFIX, token.position);
+            if (infix) {
+                infix->operator = token.operator;
+                infix->binding = binding;
+                expect_operand = 1;
             }
-            break;
+            continue;
+        }
 
-        case TOKEN_ERROR:
-            parser_set_error(parser, token.text);
-            return NULL;
-        default:
-            parser_set_error(parser, get_error_unexpected_token());
-            break;
-    }
-    
-    parser_set_error(parser, get_error_invalid_expression());
-    return NULL;
-}
+        // factor := power ('!')?
+        if (token.type == TOKEN_OPERATOR && token.operator == '!' && !after_factorial) {
+            reduce_operators(parser, &stacks, BINDING_FACTORIAL, 0);
+            parser_advance(parser);
 
-//===================================================================
-// function_call := FUNCTION '(' argument_list ')'
-// argument_list := expression (',' expression)*
-//===================================================================
-ASTNode* parse_function_call(Parser* parser, const char* function_name) {
-    parser_advance(parser);
-    
-    if (!parser_expect(parser, TOKEN_LPAREN)) {
-        parser_set_error(parser, get_error_expected_lparen_after_func());
-        return NULL;
-    }
-    parser_advance(parser);
-    
-    ASTNode** args = A89ALLOC(10 * sizeof(ASTNode*));
-    int arg_count = 0;
-    
-    if (!parser_expect(parser, TOKEN_RPAREN)) {
-        args[arg_count] = parse_expression(parser);
-        if (parser->has_error) {
-            free_function_args(args, arg_count);
-            return NULL;
+            ASTNode* operand = stacks.operands[stacks.operand_count - 1];
+            ASTNode* factorial = create_unary_op_node(parser->arena, '!', operand);
+            factorial->position = token.position;
+            stacks.operands[stacks.operand_count - 1] = factorial;
+            assignable = 0;
+            after_factorial = 1;
+            continue;
         }
-        arg_count++;
-        
-        while (parser_expect(parser, TOKEN_COMMA)) {
+
+        // assignment := IDENTIFIER '=' expression
+        if (token.type == TOKEN_ASSIGN && assignable) {
             parser_advance(parser);
-            if (arg_count >= 10) {
-                parser_set_error(parser, get_error_max_args_exceeded());
-                free_function_args(args, arg_count);
-                return NULL;
+            ParseOp* assign = push_op(parser, &stacks, PARSE_ASSIGN, token.position);
+            if (assign) {
+                assign->target = stacks.operands[--stacks.operand_count];
+                expect_operand = 1;
+                expression_start = 1;
             }
-            args[arg_count] = parse_expression(parser);
-            if (parser->has_error) {
-                free_function_args(args, arg_count);
-                return NULL;
+            continue;
+        }
+
+        // Fim da expression atual: reduz tudo até o quadro que a contém
+        reduce_operators(parser, &stacks, 0, 0);
+        assignable = 0;
+        after_factorial = 0;
+
+        // Uma atribuição ocupa a expression inteira, então o seu fim é
+        // também o fim da expression de fora. O nó da variável tem o
+        // tamanho de um nó de atribuição e vira a atribuição no lugar.
+        while (stacks.op_count > 0 && stacks.ops[stacks.op_count - 1].kind == PARSE_ASSIGN) {
+            ASTNode* assignment = stacks.ops[--stacks.op_count].target;
+            assignment->type = NODE_ASSIGNMENT;
+            assignment->as.variable.value = stacks.operands[stacks.operand_count - 1];
+            stacks.operands[stacks.operand_count - 1] = assignment;
+        }
+
+        if (stacks.op_count == 0) {
+            result = stacks.operands[--stacks.operand_count];
+            break;
+        }
+
+        ParseOp* frame = &stacks.ops[stacks.op_count - 1];
+        if (frame->kind == PARSE_GROUP) {
+            if (!parser_expect(parser, TOKEN_RPAREN)) {
+                parser_set_error(parser, get_error_expected_rparen());
+                break;
             }
-            arg_count++;
+            parser_advance(parser);
+            stacks.op_count--;
+            continue;
         }
+
+        // PARSE_CALL: próximo argumento ou fim da chamada. Os argumentos
+        // se acumulam na pilha de operandos (que dobra ao encher), então
+        // não há limite de quantidade nem cópias repetidas.
+        if (parser_expect(parser, TOKEN_COMMA)) {
+            parser_advance(parser);
+            expect_operand = 1;
+            expression_start = 1;
+            continue;
+        }
+        close_call(parser, &stacks);
     }
-    
-    if (!validate_function_args(parser, function_name, arg_count)) {
-        free_function_args(args, arg_count);
-        return NULL;
-    }
-    
-    if (!parser_expect(parser, TOKEN_RPAREN)) {
-        parser_set_error(parser, get_error_expected_rparen_after_args());
-        free_function_args(args, arg_count);
-        return NULL;
-    }
-    parser_advance(parser);
-    
-    return create_function_node(function_name, args, arg_count);
+
+    parse_stacks_free(&stacks);
+    return parser->has_error ? NULL : result;
 }
 
 //===================================================================
 // Função PRINCIPAL DE PARSING
 //===================================================================
-ASTNode* parse(Lexer* lexer) {
+ASTNode* parse(Lexer* lexer, Arena* arena) {
     Parser parser;
     parser_init(&parser, lexer);
+    parser.arena = arena;
+    
+    // Linhas vazias ou só com comentários antes da primeira instrução
+    while (parser.current_token.type == TOKEN_NEWLINE) {
+        parser_advance(&parser);
+    }
     
     if (parser.current_token.type == TOKEN_EOF) {
         return NULL;
@@ -835,44 +889,54 @@ ASTNode* parse(Lexer* lexer) {
 }
 
 void print_ast(ASTNode* node, int indent, int decimal_places) {
-    if (node == NULL) return;
-    
-    for (int i = 0; i < indent; i++) printf("    ");
-    
-    switch (node->type) {
-        case NODE_SEQUENCE:
-            printf("SEQUENCE (%d statements):\n", node->stmt_count);
-            for (int i = 0; i < node->stmt_count; i++) {
-                print_ast(node->statements[i], indent + 1, decimal_places);
-            }
-            break;
-        case NODE_NUMBER:
-            printf("NUMBER: %.*f\n", decimal_places, node->value.number);
-            break;
-        case NODE_STRING:
-            printf("STRING: %s\n", node->value.string);
-            break;
-        case NODE_VARIABLE:
-            printf("VARIABLE: %s\n", node->text);
-            break;
-        case NODE_BINARY_OP:
-            printf("BINARY_OP: %c\n", node->operator);
-            print_ast(node->left, indent + 1, decimal_places);
-            print_ast(node->right, indent + 1, decimal_places);
-            break;
-        case NODE_UNARY_OP:
-            printf("UNARY_OP: %c\n", node->operator);
-            print_ast(node->operand, indent + 1, decimal_places);
-            break;
-        case NODE_FUNCTION:
-            printf("FUNCTION: %s\n", node->function);
-            for (int i = 0; i < node->arg_count; i++) {
-                print_ast(node->args[i], indent + 1, decimal_places);
-            }
-            break;
-        case NODE_ASSIGNMENT:
-            printf("ASSIGNMENT: %s =\n", node->text);
-            print_ast(node->right, indent + 1, decimal_places);
-            break;
+    ASTWalk walk;
+    int leaving;
+
+    ast_walk_begin(&walk, node);
+    while ((node = ast_walk_next(&walk, &leaving)) != NULL) {
+        if (leaving) continue;
+
+        // Na entrada, walk.top é a profundidade do nó (raiz = 1)
+        for (int i = 0; i < indent + walk.top - 1; i++) printf("    ");
+
+        switch (node->type) {
+            case NODE_SEQUENCE:
+                printf("SEQUENCE (%d statements):\n", node->as.sequence.count);
+                break;
+            case NODE_NUMBER:
+                if (node->as.value.is_integer) {
+                    printf("INTEGER: %lld\n", (long long)node->as.value.as.integer);
+                } else {
+                    printf("NUMBER: %.*f\n", decimal_places, node->as.value.as.number);
+                }
+                break;
+            case NODE_STRING:
+                printf("STRING: %s\n", value_string(&node->as.value));
+                break;
+            case NODE_VARIABLE:
+                printf("VARIABLE: %s\n", node->as.variable.name);
+                break;
+            case NODE_BINARY_OP:
+                // << e >> ficam na AST como '<' e '>'
+                if (node->operator == '<' || node->operator == '>') {
+                    printf("BINARY_OP: %c%c\n", node->operator, node->operator);
+                } else {
+                    printf("BINARY_OP: %c\n", node->operator);
+                }
+                break;
+            case NODE_CONCAT:
+                printf("CONCAT (%d parts):\n", node->as.concat.count);
+                break;
+            case NODE_UNARY_OP:
+                printf("UNARY_OP: %c\n", node->operator);
+                break;
+            case NODE_FUNCTION:
+                printf("FUNCTION: %s\n", builtin_table[node->as.call.builtin_id].name);
+                break;
+            case NODE_ASSIGNMENT:
+                printf("ASSIGNMENT: %s =\n", node->as.variable.name);
+                break;
+        }
     }
+    ast_walk_end(&walk);
 }
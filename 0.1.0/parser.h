@@ -2,6 +2,7 @@
 #define PARSER_H
 
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,6 +11,7 @@
 #include "value.h"
 #include "lexer.h"
 #include "a89alloc.h"
+#include "arena.h"
 
 // ==================================================================
 // ÁRVORE SINTÁTICA (AST)
@@ -19,46 +21,142 @@ typedef enum {
     NODE_STRING,
     NODE_VARIABLE,
     NODE_BINARY_OP, //operacao binaria (+, -, *, /, %, ^)
+    NODE_CONCAT,    //cadeia a + b + c + ... com texto (ver optimizer.h)
     NODE_UNARY_OP,  //operacao unaria (!, -)
     NODE_FUNCTION,
     NODE_ASSIGNMENT,
     NODE_SEQUENCE 
 } NodeType;
 
+/*
+ * NÓ DA AST (união por tipo de nó)
+ *
+ * Cabeçalho comum de 8 bytes e, em seguida, só os campos do tipo do nó.
+ * Cada nó é alocado na arena com o tamanho do seu tipo (AST_NODE_SIZE),
+ * então uma expressão fica em poucos bytes contíguos, na ordem do parse.
+ * Nenhum nó é menor que um nó constante: o otimizador transforma nós
+ * no lugar em NODE_NUMBER/NODE_STRING.
+ *
+ * Só acesse o membro de 'as' correspondente a node->type, e nunca copie
+ * um ASTNode inteiro por valor.
+ */
 typedef struct ASTNode {
-    NodeType type;
-    
-    // Dados especificos do no
-    Value value;            // Para NODE_NUMBER e NODE_STRING
-    char text[STR_SIZE];    // Para NODE_VARIABLE (nome) 
+    unsigned char type;     // NodeType
     char operator;          // Para NODE_BINARY_OP e NODE_UNARY_OP
-    char function[STR_SIZE];// Para NODE_FUNCTION
-    
-    // Filhos do no
-    struct ASTNode* left;   // Filho esquerdo (operacoes binarias)
-    struct ASTNode* right;  // Filho direito (operacoes binarias)
-    struct ASTNode* operand;// Operando (operacoes unarias)
-    
-    // Para funcoes com multiplos argumentos
-    struct ASTNode** args;  // Array de argumentos
-    int arg_count;          // Numero de argumentos
-
-    // Para NODE_SEQUENCE
-    struct ASTNode** statements;  // Array de statements
-    int stmt_count;  
+    int position;           // Posição no código-fonte (-1 = desconhecida)
+
+    union {
+        // NODE_NUMBER e NODE_STRING
+        Value value;
+
+        // NODE_VARIABLE e NODE_ASSIGNMENT
+        struct {
+            const char* name;       // Nome (na arena)
+            int slot;               // Índice do slot da variável (-1 = ainda não resolvido)
+            struct ASTNode* value;  // Expressão atribuída (só NODE_ASSIGNMENT)
+        } variable;
+
+        // NODE_BINARY_OP
+        struct {
+            struct ASTNode* left;
+            struct ASTNode* right;
+        } binary;
+
+        // NODE_UNARY_OP
+        struct {
+            struct ASTNode* operand;
+        } unary;
+
+        // NODE_CONCAT: operandos da cadeia de '+', da esquerda para a direita
+        struct {
+            struct ASTNode** parts; // Operandos (array na arena)
+            int count;
+        } concat;
+
+        // NODE_FUNCTION
+        struct {
+            struct ASTNode** args;  // Argumentos (array na arena)
+            int arg_count;
+            int builtin_id;         // Índice em builtin_table
+        } call;
+
+        // NODE_SEQUENCE
+        struct {
+            struct ASTNode** statements;  // Statements (array na arena)
+            int count;
+        } sequence;
+    } as;
 } ASTNode;
 
-ASTNode* create_number_node(double value);
-ASTNode* create_variable_node(const char* variable);
-ASTNode* create_binary_op_node(char operator, ASTNode* left, ASTNode* right);
-ASTNode* create_unary_op_node(char operator, ASTNode* operand);
-ASTNode* create_function_node(const char* function, ASTNode** args, int arg_count);
-ASTNode* create_assignment_node(const char* variable, ASTNode* value);
-ASTNode* create_string_node(const char* str_value);
-ASTNode* create_sequence_node(ASTNode** statements, int stmt_count);
-
+// Bytes de um nó cujo tipo usa o membro 'member' de ASTNode.as
+#define AST_PAYLOAD_SIZE(member) sizeof(((ASTNode*)0)->as.member)
+#define AST_NODE_SIZE(member) (offsetof(ASTNode, as) + \
+    (AST_PAYLOAD_SIZE(member) > sizeof(Value) ? AST_PAYLOAD_SIZE(member) : sizeof(Value)))
+
+ASTNode* create_number_node(Arena* arena, double value);
+ASTNode* create_integer_node(Arena* arena, int64_t value);
+ASTNode* create_variable_node(Arena* arena, const char* variable);
+ASTNode* create_binary_op_node(Arena* arena, char operator, ASTNode* left, ASTNode* right);
+ASTNode* create_unary_op_node(Arena* arena, char operator, ASTNode* operand);
+ASTNode* create_function_node(Arena* arena, int builtin_id, ASTNode** args, int arg_count);
+ASTNode* create_assignment_node(Arena* arena, const char* variable, ASTNode* value);
+// O valor da string passa a pertencer ao nó
+ASTNode* create_string_node(Arena* arena, Value str_value);
+ASTNode* create_sequence_node(Arena* arena, ASTNode** statements, int stmt_count);
+
+// Libera os valores dos nós; a memória volta com arena_reset()
 void free_ast(ASTNode* node);
 
+// ==================================================================
+// PERCURSO DA AST SEM RECURSÃO
+// ==================================================================
+/*
+ * Percorre a AST com uma pilha explícita, então a profundidade da
+ * árvore é limitada pelo heap e não pela pilha de C. Cada nó aparece
+ * duas vezes em ast_walk_next(): na entrada (*leaving = 0, antes dos
+ * filhos) e na saída (*leaving = 1, depois dos filhos, da esquerda
+ * para a direita). As primeiras AST_WALK_INLINE posições da pilha
+ * ficam no próprio ASTWalk; só árvores mais profundas alocam memória.
+ *
+ * Uso:
+ *   ASTWalk walk;
+ *   ast_walk_begin(&walk, root);
+ *   while ((node = ast_walk_next(&walk, &leaving)) != NULL) { ... }
+ *   ast_walk_end(&walk);
+ *
+ * Um filho NULL ou uma falha de alocação encerram o percurso e ficam
+ * registrados em walk.error.
+ */
+#define AST_WALK_INLINE 64
+
+typedef enum {
+    AST_WALK_OK,
+    AST_WALK_NULL_CHILD,    // Nó com filho NULL
+    AST_WALK_NO_MEMORY      // Falha ao aumentar a pilha
+} ASTWalkError;
+
+typedef struct {
+    ASTNode* node;
+    int next_child;         // Próximo filho a visitar (-1 = ainda não entrou)
+    int child_count;        // ast_child_count(node), calculado na entrada
+} ASTWalkFrame;
+
+typedef struct {
+    ASTWalkFrame* frames;   // inline_frames ou vetor alocado
+    int top;                // Quadros na pilha (profundidade do nó atual)
+    int capacity;
+    ASTWalkError error;
+    ASTWalkFrame inline_frames[AST_WALK_INLINE];
+} ASTWalk;
+
+// Filhos de um nó, na ordem de avaliação
+int ast_child_count(const ASTNode* node);
+ASTNode* ast_child(const ASTNode* node, int index);
+
+void ast_walk_begin(ASTWalk* walk, ASTNode* root);
+ASTNode* ast_walk_next(ASTWalk* walk, int* leaving);
+void ast_walk_end(ASTWalk* walk);
+
 // ==================================================================
 // PARSER
 // ==================================================================
@@ -67,6 +165,8 @@ typedef struct {
     Token current_token;
     int has_error;
     char error_message[STR_SIZE];
+    Arena* arena;           // Onde os nós da AST são alocados
+    int stop_at_newline;    // parse_line(): NEWLINE encerra a statement_list
 } Parser;
 
 // Inicializa o parser
@@ -82,7 +182,7 @@ int parser_expect(Parser* parser, RTokenType expected_type);
 void parser_set_error(Parser* parser, const char* message);
 
 // Valida numero de argumentos das funcoes RUDIS
-int validate_function_args(Parser* parser, const char* function_name, int arg_count);
+int validate_function_args(Parser* parser, int builtin_id, int arg_count);
 
 
 /********************************************************************
@@ -92,32 +192,48 @@ GRAMATICA v0.0.2
 program          := statement_list
 statement_list   := statement ((';' | NEWLINE) statement)*
 statement        := expression
-expression       := assignment | arithmetic_expr
+expression       := assignment | bit_or_expr
 assignment       := IDENTIFIER '=' expression
+bit_or_expr      := bit_xor_expr ('|' bit_xor_expr)*
+bit_xor_expr     := bit_and_expr ('~' bit_and_expr)*
+bit_and_expr     := shift_expr ('&' shift_expr)*
+shift_expr       := arithmetic_expr (('<<' | '>>') arithmetic_expr)*
 arithmetic_expr  := term (('+' | '-') term)*
 term             := factor (('*' | '/' | '%') factor)*
 factor           := power ('!')?
 power            := atom ('^' power)?
-atom             := NUMBER | STRING | IDENTIFIER | function_call | '(' expression ')' | '-' atom
+atom             := NUMBER | STRING | IDENTIFIER | function_call | '(' expression ')' | ('-' | '~') atom
 function_call    := FUNCTION '(' argument_list ')'
 argument_list    := expression (',' expression)*
+
+parse_expression() reconhece expression por precedência de operadores
+(Pratt), com pilhas explícitas de operandos e de operadores, sem
+recursão: parênteses, chamadas de função e atribuições abrem um quadro
+na pilha de operadores. Força de ligação, da menor para a maior:
+  '|'              esquerda (bit a bit, ver number.h)
+  '~'              esquerda (ou exclusivo)
+  '&'              esquerda
+  '<<' '>>'        esquerda
+  '+' '-'          esquerda
+  '*' '/' '%'      esquerda
+  '!'              pós-fixo, no máximo um por factor
+  '^'              direita
+  '-' '~' (prefixo) só sobre o atom seguinte (-2^2 = (-2)^2)
 ********************************************************************/
 ASTNode* parse_program(Parser* parser); // a ser implementada quando necessário
 ASTNode* parse_statement_list(Parser* parser);
 ASTNode* parse_statement(Parser* parser);
 ASTNode* parse_expression(Parser* parser);
-ASTNode* parse_assignment(Parser* parser);
-ASTNode* parse_arithmetic_expr(Parser* parser);
-ASTNode* parse_term(Parser* parser);
-ASTNode* parse_factor(Parser* parser);
-ASTNode* parse_power(Parser* parser);
-ASTNode* parse_atom(Parser* parser);
-ASTNode* parse_function_call(Parser* parser, const char* function_name);
 
-// Funcao principal de parsing
-ASTNode* parse(Lexer* lexer);
+// Parsing incremental de scripts: devolve uma linha lógica por chamada
+// (NULL no fim da entrada ou em erro, ver parser->has_error)
+ASTNode* parse_line(Parser* parser);
+
+// Funcao principal de parsing: a AST é alocada em arena e liberada
+// com free_ast() (valores) seguido de arena_reset() (memória)
+ASTNode* parse(Lexer* lexer, Arena* arena);
 
 // Funcao para imprimir a AST (para debug)
 void print_ast(ASTNode* node, int indent, int decimal_places);
 
-#endif // PARSER_H
\ No newline at end of file
+#endif // PARSER_H
\ No newline at end of file
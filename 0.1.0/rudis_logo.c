@@ -29,4 +29,4 @@ int main() {
     printf("=========================================\n\n");
     
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
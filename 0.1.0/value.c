@@ -1,107 +1,267 @@
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 
 #include "value.h"
+#include "numfmt.h"
+#include "output.h"
+#include "width.h"
 #include "lang.h"
+#include "a89alloc.h"
 
-Value create_number_value(double num) {
+// O Value deve continuar com 16 bytes (verificação em tempo de compilação)
+typedef char value_size_check[sizeof(Value) == 16 ? 1 : -1];
+
+static Value empty_value(ValueType type) {
     Value val;
-    val.type = VAL_NUMBER;
-    val.number = num;
-    val.string[0] = '\0';  // String vazia
+    memset(&val, 0, sizeof(val));
+    val.type = (unsigned char)type;
     return val;
 }
 
-Value create_string_value(const char* str) {
+Value create_number_value(double num) {
+    Value val = empty_value(VAL_NUMBER);
+    val.as.number = num;
+    return val;
+}
+
+Value create_integer_value(int64_t integer) {
+    Value val = empty_value(VAL_NUMBER);
+    val.is_integer = 1;
+    val.as.integer = integer;
+    return val;
+}
+
+char* create_string_buffer(Value* val, int length) {
+    *val = empty_value(VAL_STRING);
+    if (length < 0) length = 0;
+
+    if (length <= VALUE_SMALL_MAX) {
+        // String curta: fica dentro do próprio Value
+        val->small_length = (unsigned char)length;
+        val->as.small[length] = '\0';
+        return val->as.small;
+    }
+
+    RudisString* heap = (RudisString*)A89ALLOC(sizeof(RudisString) + length + 1);
+    if (!heap) {
+        // Sem memória: string vazia
+        return val->as.small;
+    }
+    heap->refcount = 1;
+    heap->length = length;
+    heap->width = -1;
+    heap->data[length] = '\0';
+    val->small_length = VALUE_HEAP_STRING;
+    val->as.heap = heap;
+    return heap->data;
+}
+
+Value create_string_value_length(const char* str, int length) {
     Value val;
-    val.type = VAL_STRING;
-    val.number = 0.0;      // Número zerado
-    strncpy(val.string, str, sizeof(val.string) - 1);
-    val.string[sizeof(val.string) - 1] = '\0';
+    char* data = create_string_buffer(&val, length);
+    if (value_length(&val) == length) {
+        memcpy(data, str, length);
+    }
     return val;
 }
 
+Value create_string_value(const char* str) {
+    return create_string_value_length(str, (int)strlen(str));
+}
+
 Value create_null_value(void){
-    Value val;
-    val.type = VAL_NULL;
-    val.number = 0.0;
-    val.string[0] = '\0';
+    return empty_value(VAL_NULL);
+}
+
+Value create_undefined_value(void){
+    return empty_value(VAL_UNDEFINED);
+}
+
+const char* value_string(const Value* val) {
+    if (val->type != VAL_STRING) return "";
+    if (val->small_length == VALUE_HEAP_STRING) return val->as.heap->data;
+    return val->as.small;
+}
+
+int value_length(const Value* val) {
+    if (val->type != VAL_STRING) return 0;
+    if (val->small_length == VALUE_HEAP_STRING) return val->as.heap->length;
+    return val->small_length;
+}
+
+int value_display_width(const Value* val) {
+    if (val->type != VAL_STRING) return 0;
+    if (val->small_length != VALUE_HEAP_STRING) {
+        return text_display_width(val->as.small, val->small_length);
+    }
+
+    RudisString* heap = val->as.heap;
+    if (heap->width < 0) {
+        heap->width = text_display_width(heap->data, heap->length);
+    }
+    return heap->width;
+}
+
+Value value_retain(Value val) {
+    if (val.type == VAL_STRING && val.small_length == VALUE_HEAP_STRING) {
+        val.as.heap->refcount++;
+    }
     return val;
 }
 
+void value_release(Value* val) {
+    if (val->type == VAL_STRING && val->small_length == VALUE_HEAP_STRING) {
+        if (--val->as.heap->refcount == 0) {
+            a89free(val->as.heap);
+        }
+    }
+    *val = empty_value(VAL_NULL);
+}
+
+//===================================================================
+// ESTILOS
+//===================================================================
+// Códigos SGR dos bits de attributes, na ordem STYLE_BOLD..STYLE_STRIKETHROUGH
+static const unsigned char attribute_codes[8] = { 1, 2, 3, 4, 5, 7, 8, 9 };
+
+static int value_has_style(const Value* val) {
+    return (val->foreground | val->background | val->attributes) != 0;
+}
+
+static char* write_code(char* out, unsigned char code) {
+    if (code >= 100) *out++ = (char)('0' + code / 100);
+    if (code >= 10) *out++ = (char)('0' + code / 10 % 10);
+    *out++ = (char)('0' + code % 10);
+    *out++ = ';';
+    return out;
+}
+
+// Uma única sequência ESC[a;b;...m com o estilo de val; devolve o comprimento
+static int style_escape(const Value* val, char* buffer) {
+    char* out = buffer;
+    *out++ = '\033';
+    *out++ = '[';
+    for (int i = 0; i < 8; i++) {
+        if (val->attributes & (1 << i)) out = write_code(out, attribute_codes[i]);
+    }
+    if (val->foreground) out = write_code(out, val->foreground);
+    if (val->background) out = write_code(out, val->background);
+    out[-1] = 'm';      // Troca o último ';'
+    return (int)(out - buffer);
+}
+
 void print_value(Value val, int decimal_places) {
     switch (val.type) {
         case VAL_NUMBER:
-            printf("%.*f", decimal_places, val.number);
+            {
+                char buffer[NUMBER_BUFFER_SIZE];
+                int length = val.is_integer
+                    ? format_integer(buffer, val.as.integer, decimal_places)
+                    : format_number_fixed(buffer, val.as.number, decimal_places);
+                output_write(buffer, (size_t)length);
+            }
             break;
         case VAL_STRING:
-            printf("%s", val.string);
+            if (value_has_style(&val) && output_colors_enabled()) {
+                char escape[STYLE_ESCAPE_SIZE];
+                output_write(escape, (size_t)style_escape(&val, escape));
+                output_write(value_string(&val), (size_t)value_length(&val));
+                output_write(RESET, sizeof(RESET) - 1);
+            } else {
+                output_write(value_string(&val), (size_t)value_length(&val));
+            }
             break;
         case VAL_NULL:
-            printf("null");
+            output_string("null");
             break;
         default:
-            printf("unknown");
+            output_string("unknown");
             break;
     }
 }
 
-Value number_to_string_value(double number, int decimal_places) {
-    Value result;
-    result.type = VAL_STRING;
-    
-    char buffer[STR_SIZE];
-    
-    // Casos especiais primeiro
-    if (isnan(number)) {
-        strcpy(result.string, "nan");
-        return result;
+#define SPACES_SIZE 64
+
+static void write_spaces(int count) {
+    static const char spaces[SPACES_SIZE + 1] =
+        "                                                                ";
+    while (count > 0) {
+        int chunk = count < SPACES_SIZE ? count : SPACES_SIZE;
+        output_write(spaces, (size_t)chunk);
+        count -= chunk;
     }
-    
-    if (isinf(number)) {
-        if (number > 0) {
-            strcpy(result.string, "inf");
-        } else {
-            strcpy(result.string, "-inf");
-        }
-        return result;
+}
+
+void print_value_aligned(Value val, int decimal_places, int width, Alignment alignment) {
+    char buffer[NUMBER_BUFFER_SIZE];
+    const char* text;
+    int length;
+    int visible_width;
+
+    switch (val.type) {
+        case VAL_NUMBER:
+            length = val.is_integer
+                ? format_integer(buffer, val.as.integer, decimal_places)
+                : format_number_fixed(buffer, val.as.number, decimal_places);
+            text = buffer;
+            visible_width = length;
+            break;
+        case VAL_STRING:
+            text = value_string(&val);
+            length = value_length(&val);
+            visible_width = value_display_width(&val);
+            break;
+        case VAL_NULL:
+            text = "null";
+            length = visible_width = 4;
+            break;
+        default:
+            text = "unknown";
+            length = visible_width = 7;
+            break;
     }
-    
-    // Número muito grande ou muito pequeno? Usar notação científica
-    if (fabs(number) >= 1e9 || (fabs(number) <= 1e-9 && number != 0)) {
-        snprintf(buffer, STR_SIZE, "%g", number);
+
+    int spaces = width > visible_width ? width - visible_width : 0;
+    int left_spaces = 0;
+    if (alignment == ALIGN_RIGHT) {
+        left_spaces = spaces;
+    } else if (alignment == ALIGN_CENTER) {
+        left_spaces = spaces / 2;
+    }
+
+    write_spaces(left_spaces);
+    if (value_has_style(&val) && output_colors_enabled()) {
+        char escape[STYLE_ESCAPE_SIZE];
+        output_write(escape, (size_t)style_escape(&val, escape));
+        output_write(text, (size_t)length);
+        output_write(RESET, sizeof(RESET) - 1);
     } else {
-        // Formato normal
-        if (decimal_places < 0) {
-            // Formato inteligente: remove .0 se for inteiro
-            if (number == (int)number) {
-                snprintf(buffer, STR_SIZE, "%d", (int)number);
-            } else {
-                snprintf(buffer, STR_SIZE, "%g", number);
-            }
-        } else {
-            // Número fixo de casas decimais
-            snprintf(buffer, STR_SIZE, "%.*f", decimal_places, number);
-        }
+        output_write(text, (size_t)length);
     }
-    
-    // Copiar para a string do resultado
-    strncpy(result.string, buffer, STR_SIZE - 1);
-    result.string[STR_SIZE - 1] = '\0';
-    
-    return result;
+    write_spaces(spaces - left_spaces);
+}
+
+Value number_to_string_value(double number, int decimal_places) {
+    // Regras de formato em format_number() (numfmt.h)
+    char buffer[NUMBER_BUFFER_SIZE];
+    int length = format_number(buffer, number, decimal_places);
+    return create_string_value_length(buffer, length);
 }
 
 Value value_to_string_value(Value value, int decimal_places) {
     switch (value.type) {
         case VAL_STRING:
-            // Já é string, retornar cópia
-            return create_string_value(value.string);
+            // Já é string, retornar nova referência
+            return value_retain(value);
             
         case VAL_NUMBER:
-            // Converter número para string
-            return number_to_string_value(value.number, decimal_places);
+            // Converter número para string (inteiros com todos os dígitos)
+            if (value.is_integer) {
+                char buffer[NUMBER_BUFFER_SIZE];
+                int length = format_integer(buffer, value.as.integer, decimal_places);
+                return create_string_value_length(buffer, length);
+            }
+            return number_to_string_value(value.as.number, decimal_places);
             
         case VAL_NULL:
             // Null vira "null"
@@ -113,438 +273,374 @@ Value value_to_string_value(Value value, int decimal_places) {
     }
 }
 
+Value value_to_plain_string(Value value, int decimal_places) {
+    Value str = value_to_string_value(value, decimal_places);
+    if (!value_has_style(&str)) return str;
+
+    if (!output_colors_enabled()) {
+        // Sem cores o estilo some e o texto é o mesmo (sem cópia)
+        str.foreground = 0;
+        str.background = 0;
+        str.attributes = 0;
+        return str;
+    }
+
+    char escape[STYLE_ESCAPE_SIZE];
+    int escape_len = style_escape(&str, escape);
+    int text_len = value_length(&str);
+    int reset_len = (int)sizeof(RESET) - 1;
+
+    Value result;
+    char* data = create_string_buffer(&result, escape_len + text_len + reset_len);
+    if (value_length(&result) == escape_len + text_len + reset_len) {
+        memcpy(data, escape, escape_len);
+        memcpy(data + escape_len, value_string(&str), text_len);
+        memcpy(data + escape_len + text_len, RESET, reset_len);
+    }
+    value_release(&str);
+    return result;
+}
+
 //===================================================================
 // FUNÇÕES DE CORES DO TEXTO
 //===================================================================
-static Value apply_ansi(Value text, const char* ansi_code) {
+// Nova referência ao texto com o estilo somado. A cor já presente
+// (estilo mais interno) é mantida; atributos se acumulam.
+static Value apply_style(Value text, unsigned char foreground,
+                         unsigned char background, unsigned char attributes) {
     if (text.type != VAL_STRING) {
         text = value_to_string_value(text, -1);
+    } else if (text.small_length == VALUE_HEAP_STRING) {
+        text.as.heap->refcount++;   // Mesma string, nova referência
     }
-    Value result;
-    result.type = VAL_STRING;
-    snprintf(result.string, STR_SIZE, "%s%s%s", ansi_code, text.string, RESET);
-    return result;
+    if (text.foreground == 0) text.foreground = foreground;
+    if (text.background == 0) text.background = background;
+    text.attributes |= attributes;
+    return text;
 }
 
+// Códigos SGR: 30-37 cores, 90-97 cores claras; fundo = cor + 10
 // ==================== CORES DO TEXTO ====================
 Value black(Value text) {
-    return apply_ansi(text, BLACK);
+    return apply_style(text, 30, 0, 0);
 }
 
 Value red(Value text) {
-    return apply_ansi(text, RED);
+    return apply_style(text, 31, 0, 0);
 }
 
 Value green(Value text) {
-    return apply_ansi(text, GREEN);
+    return apply_style(text, 32, 0, 0);
 }
 
 Value yellow(Value text) {
-    return apply_ansi(text, YELLOW);
+    return apply_style(text, 33, 0, 0);
 }
 
 Value blue(Value text) {
-    return apply_ansi(text, BLUE);
+    return apply_style(text, 34, 0, 0);
 }
 
 Value magenta(Value text) {
-    return apply_ansi(text, MAGENTA);
+    return apply_style(text, 35, 0, 0);
 }
 
 Value cyan(Value text) {
-    return apply_ansi(text, CYAN);
+    return apply_style(text, 36, 0, 0);
 }
 
 Value white(Value text) {
-    return apply_ansi(text, WHITE);
+    return apply_style(text, 37, 0, 0);
 }
 
 Value bright_black(Value text) {
-    return apply_ansi(text, BRIGHT_BLACK);
+    return apply_style(text, 90, 0, 0);
 }
 
 Value bright_red(Value text) {
-    return apply_ansi(text, BRIGHT_RED);
+    return apply_style(text, 91, 0, 0);
 }
 
 Value bright_green(Value text) {
-    return apply_ansi(text, BRIGHT_GREEN);
+    return apply_style(text, 92, 0, 0);
 }
 
 Value bright_yellow(Value text) {
-    return apply_ansi(text, BRIGHT_YELLOW);
+    return apply_style(text, 93, 0, 0);
 }
 
 Value bright_blue(Value text) {
-    return apply_ansi(text, BRIGHT_BLUE);
+    return apply_style(text, 94, 0, 0);
 }
 
 Value bright_magenta(Value text) {
-    return apply_ansi(text, BRIGHT_MAGENTA);
+    return apply_style(text, 95, 0, 0);
 }
 
 Value bright_cyan(Value text) {
-    return apply_ansi(text, BRIGHT_CYAN);
+    return apply_style(text, 96, 0, 0);
 }
 
 Value bright_white(Value text) {
-    return apply_ansi(text, BRIGHT_WHITE);
+    return apply_style(text, 97, 0, 0);
 }
 
 // ==================== CORES DE FUNDO ====================
 Value bg_black(Value text) {
-    return apply_ansi(text, BG_BLACK);
+    return apply_style(text, 0, 40, 0);
 }
 
 Value bg_red(Value text) {
-    return apply_ansi(text, BG_RED);
+    return apply_style(text, 0, 41, 0);
 }
 
 Value bg_green(Value text) {
-    return apply_ansi(text, BG_GREEN);
+    return apply_style(text, 0, 42, 0);
 }
 
 Value bg_yellow(Value text) {
-    return apply_ansi(text, BG_YELLOW);
+    return apply_style(text, 0, 43, 0);
 }
 
 Value bg_blue(Value text) {
-    return apply_ansi(text, BG_BLUE);
+    return apply_style(text, 0, 44, 0);
 }
 
 Value bg_magenta(Value text) {
-    return apply_ansi(text, BG_MAGENTA);
+    return apply_style(text, 0, 45, 0);
 }
 
 Value bg_cyan(Value text) {
-    return apply_ansi(text, BG_CYAN);
+    return apply_style(text, 0, 46, 0);
 }
 
 Value bg_white(Value text) {
-    return apply_ansi(text, BG_WHITE);
+    return apply_style(text, 0, 47, 0);
 }
 
 Value bg_bright_black(Value text) {
-    return apply_ansi(text, BG_BRIGHT_BLACK);
+    return apply_style(text, 0, 100, 0);
 }
 
 Value bg_bright_red(Value text) {
-    return apply_ansi(text, BG_BRIGHT_RED);
+    return apply_style(text, 0, 101, 0);
 }
 
 Value bg_bright_green(Value text) {
-    return apply_ansi(text, BG_BRIGHT_GREEN);
+    return apply_style(text, 0, 102, 0);
 }
 
 Value bg_bright_yellow(Value text) {
-    return apply_ansi(text, BG_BRIGHT_YELLOW);
+    return apply_style(text, 0, 103, 0);
 }
 
 Value bg_bright_blue(Value text) {
-    return apply_ansi(text, BG_BRIGHT_BLUE);
+    return apply_style(text, 0, 104, 0);
 }
 
 Value bg_bright_magenta(Value text) {
-    return apply_ansi(text, BG_BRIGHT_MAGENTA);
+    return apply_style(text, 0, 105, 0);
 }
 
 Value bg_bright_cyan(Value text) {
-    return apply_ansi(text, BG_BRIGHT_CYAN);
+    return apply_style(text, 0, 106, 0);
 }
 
 Value bg_bright_white(Value text) {
-    return apply_ansi(text, BG_BRIGHT_WHITE);
+    return apply_style(text, 0, 107, 0);
 }
 
 // ==================== ESTILOS ====================
 Value bold(Value text) {
-    return apply_ansi(text, BOLD);
+    return apply_style(text, 0, 0, STYLE_BOLD);
 }
 
 Value dim(Value text) {
-    return apply_ansi(text, DIM);
+    return apply_style(text, 0, 0, STYLE_DIM);
 }
 
 Value italic(Value text) {
-    return apply_ansi(text, ITALIC);
+    return apply_style(text, 0, 0, STYLE_ITALIC);
 }
 
 Value underline(Value text) {
-    return apply_ansi(text, UNDERLINE);
+    return apply_style(text, 0, 0, STYLE_UNDERLINE);
 }
 
 Value blink(Value text) {
-    return apply_ansi(text, BLINK);
+    return apply_style(text, 0, 0, STYLE_BLINK);
 }
 
 Value inverse(Value text) {
-    return apply_ansi(text, INVERSE);
+    return apply_style(text, 0, 0, STYLE_INVERSE);
 }
 
 Value hidden(Value text) {
-    return apply_ansi(text, HIDDEN);
+    return apply_style(text, 0, 0, STYLE_HIDDEN);
 }
 
 Value strikethrough(Value text) {
-    return apply_ansi(text, STRIKETHROUGH);
+    return apply_style(text, 0, 0, STYLE_STRIKETHROUGH);
 }
 
 //===================================================================
 // FUNÇÕES DE ALINHAMENTO
 //===================================================================
 
-// REMOVE CÓDIGOS ANSI PARA CONTAR APENAS O TEXTO VISÍVEL:
-static int visible_length(const char* str) {
-    int len = 0;
-    int i = 0;
-    
-    while (str[i] != '\0') {
-        // Detecta sequência ANSI: ESC [ ... m
-        if (str[i] == '\033' && str[i+1] == '[') {
-            // Pula a sequência ANSI
-            i += 2; // Pula ESC [
-            while (str[i] != '\0' && str[i] != 'm') {
-                i++;
-            }
-            if (str[i] == 'm') i++;
-        } else {
-            // Caractere normal
-            len++;
-            i++;
-        }
+// Completa text com espaços até width colunas (largura de exibição, ver
+// width.h). Os espaços ficam fora do estilo do texto.
+static Value apply_alignment(Value text, int width, Alignment alignment) {
+    Value str = value_to_string_value(text, -1);
+
+    // O estilo não ocupa colunas: a largura (guardada na string) é a do
+    // texto sem os códigos
+    int visible_width = value_display_width(&str);
+    if (visible_width >= width) {
+        // Texto já é maior ou igual à largura: volta como está
+        return str;
     }
-    
-    return len;
-}
 
-static Value apply_alignment(Value text, int width, const char* align_type) {
-    if (text.type != VAL_STRING) {
-        text = value_to_string_value(text, -1);
+    Value plain = value_to_plain_string(str, -1);
+    value_release(&str);
+    const char* content = value_string(&plain);
+    int text_len = value_length(&plain);
+
+    int spaces = width - visible_width;
+    int left_spaces = 0;
+    if (alignment == ALIGN_RIGHT) {
+        left_spaces = spaces;
+    } else if (alignment == ALIGN_CENTER) {
+        left_spaces = spaces / 2;
     }
-    
+
     Value result;
-    result.type = VAL_STRING;
-    
-    // Calcula comprimento visível (sem códigos ANSI)
-    int visible_len = visible_length(text.string);
-    
-    if (visible_len >= width) {
-        // Texto já é maior ou igual à largura visível
-        // Podemos truncar mantendo códigos ANSI?
-        // Por simplicidade, retornamos o texto original
-        strncpy(result.string, text.string, STR_SIZE - 1);
-        result.string[STR_SIZE - 1] = '\0';
-    } else {
-        int spaces = width - visible_len;
-        
-        if (strcmp(align_type, "left") == 0) {
-            // Alinhamento à esquerda: texto + espaços
-            // Precisamos construir manualmente para manter códigos ANSI
-            strncpy(result.string, text.string, STR_SIZE - 1);
-            for (int i = 0; i < spaces; i++) {
-                strncat(result.string, " ", STR_SIZE - strlen(result.string) - 1);
-            }
-        } 
-        else if (strcmp(align_type, "right") == 0) {
-            // Alinhamento à direita: espaços + texto
-            result.string[0] = '\0';
-            for (int i = 0; i < spaces; i++) {
-                strncat(result.string, " ", STR_SIZE - strlen(result.string) - 1);
-            }
-            strncat(result.string, text.string, STR_SIZE - strlen(result.string) - 1);
-        }
-        else if (strcmp(align_type, "center") == 0) {
-            // Alinhamento ao centro
-            int left_spaces = spaces / 2;
-            int right_spaces = spaces - left_spaces;
-            
-            result.string[0] = '\0';
-            
-            // Espaços à esquerda
-            for (int i = 0; i < left_spaces; i++) {
-                strncat(result.string, " ", STR_SIZE - strlen(result.string) - 1);
-            }
-            
-            // Texto
-            strncat(result.string, text.string, STR_SIZE - strlen(result.string) - 1);
-            
-            // Espaços à direita
-            for (int i = 0; i < right_spaces; i++) {
-                strncat(result.string, " ", STR_SIZE - strlen(result.string) - 1);
-            }
+    char* data = create_string_buffer(&result, text_len + spaces);
+    if (value_length(&result) == text_len + spaces) {
+        memset(data, ' ', left_spaces);
+        memcpy(data + left_spaces, content, text_len);
+        memset(data + left_spaces + text_len, ' ', spaces - left_spaces);
+        if (result.small_length == VALUE_HEAP_STRING) {
+            result.as.heap->width = width;
         }
     }
-    
+    value_release(&plain);
     return result;
 }
 
 // left(CAMPO, TEXTO) - Alinha à esquerda
 Value left(Value args[], int arg_count) {
     if (arg_count != 2) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE, 
-                     "Erro: left requer exatamente 2 argumentos (largura, texto)");
+            return create_string_value("Erro: left requer exatamente 2 argumentos (largura, texto)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: left requires exactly 2 arguments (width, text)");
+            return create_string_value("Error: left requires exactly 2 arguments (width, text)");
         }
-        return error;
     }
     
     // Primeiro argumento deve ser número (largura)
     if (args[0].type != VAL_NUMBER) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE,
-                     "Erro: primeiro argumento de left deve ser número (largura)");
+            return create_string_value("Erro: primeiro argumento de left deve ser número (largura)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: first argument of left must be a number (width)");
+            return create_string_value("Error: first argument of left must be a number (width)");
         }
-        return error;
     }
     
-    int width = (int)args[0].number;
+    int width = (int)VALUE_AS_DOUBLE(args[0]);
     if (width < 0) width = 0;
-    if (width >= STR_SIZE) width = STR_SIZE - 1;
     
-    return apply_alignment(args[1], width, "left");
+    return apply_alignment(args[1], width, ALIGN_LEFT);
 }
 
 // center(CAMPO, TEXTO) - Alinha ao centro
 Value center(Value args[], int arg_count) {
     if (arg_count != 2) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE,
-                     "Erro: center requer exatamente 2 argumentos (largura, texto)");
+            return create_string_value("Erro: center requer exatamente 2 argumentos (largura, texto)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: center requires exactly 2 arguments (width, text)");
+            return create_string_value("Error: center requires exactly 2 arguments (width, text)");
         }
-        return error;
     }
     
     if (args[0].type != VAL_NUMBER) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE,
-                     "Erro: primeiro argumento de center deve ser número (largura)");
+            return create_string_value("Erro: primeiro argumento de center deve ser número (largura)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: first argument of center must be a number (width)");
+            return create_string_value("Error: first argument of center must be a number (width)");
         }
-        return error;
     }
     
-    int width = (int)args[0].number;
+    int width = (int)VALUE_AS_DOUBLE(args[0]);
     if (width < 0) width = 0;
-    if (width >= STR_SIZE) width = STR_SIZE - 1;
     
-    return apply_alignment(args[1], width, "center");
+    return apply_alignment(args[1], width, ALIGN_CENTER);
 }
 
 // right(CAMPO, TEXTO) - Alinha à direita
 Value right(Value args[], int arg_count) {
     if (arg_count != 2) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE,
-                     "Erro: right requer exatamente 2 argumentos (largura, texto)");
+            return create_string_value("Erro: right requer exatamente 2 argumentos (largura, texto)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: right requires exactly 2 arguments (width, text)");
+            return create_string_value("Error: right requires exactly 2 arguments (width, text)");
         }
-        return error;
     }
     
     if (args[0].type != VAL_NUMBER) {
-        Value error;
-        error.type = VAL_STRING;
         if (current_lang == LANG_PT) {
-            snprintf(error.string, STR_SIZE,
-                     "Erro: primeiro argumento de right deve ser número (largura)");
+            return create_string_value("Erro: primeiro argumento de right deve ser número (largura)");
         } else {
-            snprintf(error.string, STR_SIZE,
-                     "Error: first argument of right must be a number (width)");
+            return create_string_value("Error: first argument of right must be a number (width)");
         }
-        return error;
     }
     
-    int width = (int)args[0].number;
+    int width = (int)VALUE_AS_DOUBLE(args[0]);
     if (width < 0) width = 0;
-    if (width >= STR_SIZE) width = STR_SIZE - 1;
     
-    return apply_alignment(args[1], width, "right");
+    return apply_alignment(args[1], width, ALIGN_RIGHT);
 }
 
 //===================================================================
 // FUNÇÃO REPEAT 
 //===================================================================
 Value repeat(Value caractere, Value quantidade) {
-    Value result;
-    result.type = VAL_STRING;
-    
     // Verifica se caractere é string
     if (caractere.type != VAL_STRING) {
         if (current_lang == LANG_PT) {
-            snprintf(result.string, STR_SIZE, 
-                     "Erro: primeiro argumento de repeat deve ser string");
+            return create_string_value("Erro: primeiro argumento de repeat deve ser string");
         } else {
-            snprintf(result.string, STR_SIZE,
-                     "Error: first argument of repeat must be a string");
+            return create_string_value("Error: first argument of repeat must be a string");
         }
-        return result;
     }
 
     // Verifica se quantidade é número
     if (quantidade.type != VAL_NUMBER) {
         if (current_lang == LANG_PT) {
-            snprintf(result.string, STR_SIZE, 
-                     "Erro: segundo argumento de repeat deve ser número (quantidade)");
+            return create_string_value("Erro: segundo argumento de repeat deve ser número (quantidade)");
         } else {
-            snprintf(result.string, STR_SIZE,
-                     "Error: second argument of repeat must be a number (count)");
+            return create_string_value("Error: second argument of repeat must be a number (count)");
         }
-        return result;
     }
     
-    int count = (int)quantidade.number;
+    int count = (int)VALUE_AS_DOUBLE(quantidade);
     if (count < 0) count = 0;
     
-    // Limita o tamanho para evitar overflow
-    if (count >= STR_SIZE) {
-        count = STR_SIZE - 1;
-    }
-    
-    // Obtém o caractere a repetir
-    char repeat_char = ' ';
-    
     // String vazia, retorna string vazia
-    if (strlen(caractere.string) == 0) {
-        result.string[0] = '\0';
-        return result;
+    if (value_length(&caractere) == 0) {
+        return create_string_value("");
     }
 
     // Pega o primeiro caractere da string
-    repeat_char = caractere.string[0];
-    
-    // NULL = espaço
-    if(caractere.type == VAL_NULL) {
-        repeat_char = ' ';
-    }
+    char repeat_char = value_string(&caractere)[0];
     
     // Cria a string repetida
-    for (int i = 0; i < count; i++) {
-        result.string[i] = repeat_char;
-    }
-    result.string[count] = '\0';
-    
+    Value result;
+    char* data = create_string_buffer(&result, count);
+    memset(data, repeat_char, value_length(&result));
+
+    // repeat(red("="), 10): o estilo vale para a string repetida
+    result.foreground = caractere.foreground;
+    result.background = caractere.background;
+    result.attributes = caractere.attributes;
     return result;
 }
@@ -1,6 +1,8 @@
 #ifndef VALUE_H
 #define VALUE_H
 
+#include <stdint.h>
+
 #include "common.h"
 #include "color.h"
 
@@ -8,22 +10,131 @@ typedef enum {
     VAL_NUMBER,
     VAL_STRING,
     VAL_NULL,
-    VAL_ERROR
+    VAL_ERROR,
+    VAL_UNDEFINED   // Slot de variável ainda não atribuído (uso interno do avaliador)
 } ValueType;
 
+/*
+ * STRING COM CONTAGEM DE REFERÊNCIAS
+ *
+ * Strings que não cabem dentro do Value ficam no heap e são
+ * compartilhadas entre cópias do Value (variáveis, argumentos, nós da
+ * AST). O bloco é liberado quando a última referência é solta.
+ */
+typedef struct RudisString {
+    int refcount;       // Número de Values que apontam para o bloco
+    int length;         // Comprimento em bytes (sem o '\0')
+    int width;          // Colunas na tela (-1 = ainda não calculada)
+    char data[];        // Conteúdo, sempre terminado em '\0'
+} RudisString;
+
+#define VALUE_SMALL_MAX 7       // Strings de até 7 bytes ficam dentro do Value
+#define VALUE_HEAP_STRING 0xFF  // small_length indicando string no heap
+
+/*
+ * VALOR - RUDIS (16 bytes)
+ *
+ * - VAL_NUMBER: inteiro exato em as.integer (is_integer = 1) ou double
+ *   em as.number (is_integer = 0); ver number.h
+ * - VAL_STRING: string curta em as.small (small_length bytes) ou
+ *   string no heap em as.heap (small_length == VALUE_HEAP_STRING).
+ *   foreground, background e attributes guardam o estilo de red(),
+ *   bg_blue(), bold()... sem tocar no texto (ver ESTILOS abaixo)
+ *
+ * Regras de posse:
+ * - Um Value com string no heap possui uma referência ao bloco.
+ * - Funções que recebem Value como parâmetro apenas o emprestam.
+ * - Funções que retornam Value entregam uma referência nova ao chamador,
+ *   que deve soltá-la com value_release() (ou guardá-la).
+ * - Para duplicar um Value use value_retain().
+ */
 typedef struct Value {
-    ValueType type;
-    double number;
-    char string[STR_SIZE];
+    unsigned char type;             // ValueType
+    unsigned char small_length;     // Comprimento da string curta ou VALUE_HEAP_STRING
+    unsigned char foreground;       // Código SGR da cor do texto (0 = sem cor)
+    unsigned char background;       // Código SGR da cor de fundo (0 = sem cor)
+    unsigned char attributes;       // STYLE_BOLD | STYLE_DIM | ...
+    unsigned char is_integer;       // VAL_NUMBER: o valor está em as.integer
+    unsigned char reserved[2];
+    union {
+        double number;
+        int64_t integer;
+        RudisString* heap;
+        char small[VALUE_SMALL_MAX + 1];
+    } as;
 } Value;
 
 Value create_number_value(double num);
+Value create_integer_value(int64_t integer);
 Value create_string_value(const char* str);
+Value create_string_value_length(const char* str, int length);
 Value create_null_value(void);
+Value create_undefined_value(void);
+
+// Valor de um VAL_NUMBER como double (inteiros são convertidos)
+#define VALUE_AS_DOUBLE(val) ((val).is_integer ? (double)(val).as.integer : (val).as.number)
+
+// Inicializa *val como string de comprimento length e devolve o buffer
+// (length + 1 bytes, já terminado em '\0') para ser preenchido pelo
+// chamador. Em falha de alocação *val vira string vazia.
+char* create_string_buffer(Value* val, int length);
+
+// Conteúdo e comprimento de um Value do tipo VAL_STRING
+const char* value_string(const Value* val);
+int value_length(const Value* val);
+
+// Colunas que a string ocupa na tela (width.h). Em strings no heap o
+// resultado fica guardado no bloco: alinhar de novo o mesmo valor (uma
+// variável em várias linhas de uma tabela) não percorre o texto.
+int value_display_width(const Value* val);
+
+// Contagem de referências das strings no heap
+Value value_retain(Value val);
+void value_release(Value* val);
+
 void print_value(Value val, int decimal_places);
+
+typedef enum {
+    ALIGN_LEFT,
+    ALIGN_CENTER,
+    ALIGN_RIGHT
+} Alignment;
+
+// Como print_value(), completando com espaços até width colunas na tela
+// (sem criar string intermediária). Os espaços ficam fora do estilo.
+void print_value_aligned(Value val, int decimal_places, int width, Alignment alignment);
 Value number_to_string_value(double number, int decimal_places);
 Value value_to_string_value(Value value, int decimal_places);
 
+//===================================================================
+// ESTILOS
+//===================================================================
+/*
+ * As funções de cor e estilo não copiam o texto: devolvem uma nova
+ * referência à mesma string com o estilo nos campos do Value. Em
+ * estilos aninhados a cor mais interna vale (como nas sequências
+ * antigas, em que o código interno vinha depois) e os atributos se
+ * somam. print_value() escreve uma única sequência ESC[...m antes do
+ * texto e um RESET depois, e nenhuma quando output_colors_enabled()
+ * é 0 (saída que não é terminal ou NO_COLOR definido).
+ */
+#define STYLE_BOLD          0x01
+#define STYLE_DIM           0x02
+#define STYLE_ITALIC        0x04
+#define STYLE_UNDERLINE     0x08
+#define STYLE_BLINK         0x10
+#define STYLE_INVERSE       0x20
+#define STYLE_HIDDEN        0x40
+#define STYLE_STRIKETHROUGH 0x80
+
+#define STYLE_ESCAPE_SIZE 32    // Maior sequência: ESC[1;2;3;4;5;7;8;9;97;107m
+
+// Como value_to_string_value(), mas sem estilo separado: para operações
+// que juntam textos (concatenação, alinhamento) os códigos ANSI passam
+// a fazer parte do texto, ou são descartados se as cores estiverem
+// desligadas.
+Value value_to_plain_string(Value value, int decimal_places);
+
 
 
 //===================================================================
@@ -91,4 +202,4 @@ Value right(Value args[], int arg_count);
 //===================================================================
 Value repeat(Value caractere, Value quantidade);
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
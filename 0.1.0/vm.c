@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "vm.h"
+#include "lang.h"
+#include "functions.h"
+#include "number.h"
+
+#if defined(__GNUC__) && !defined(VM_NO_COMPUTED_GOTO)
+#define VM_COMPUTED_GOTO 1
+// "goto *" e "&&rótulo" são extensões do GNU C
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+//===================================================================
+// DESPACHO
+//===================================================================
+// VM_CASE marca o início do tratamento de um opcode e VM_NEXT busca e
+// despacha a próxima instrução. Com computed goto cada instrução salta
+// direto para o seu rótulo; sem ele, o laço volta ao switch.
+#ifdef VM_COMPUTED_GOTO
+#define VM_CASE(op) label_##op:
+#define VM_NEXT() do { instruction = *ip++; goto *dispatch_table[OP_CODE(instruction)]; } while (0)
+#define VM_LOOP_BEGIN VM_NEXT();
+#define VM_LOOP_END
+#else
+#define VM_CASE(op) case op:
+#define VM_NEXT() continue
+#define VM_LOOP_BEGIN for (;;) { instruction = *ip++; switch (OP_CODE(instruction)) {
+#define VM_LOOP_END default: goto invalid_opcode; } }
+#endif
+
+#define IS_NUMBER(value) ((value).type == VAL_NUMBER)
+
+// Dois doubles: a conta fica na VM, sem chamar number.c
+#define BOTH_DOUBLE(a, b) (!((a).is_integer | (b).is_integer))
+
+// Solta um valor da pilha (números não têm referência a soltar)
+#define RELEASE(value) do { if (!IS_NUMBER(*(value))) value_release(value); } while (0)
+
+// Erro gerado pela própria VM: mensagem no idioma atual
+#define VM_ERROR(pt, en) do { \
+        create_error_result(state, current_lang == LANG_PT ? (pt) : (en)); \
+        goto error; \
+    } while (0)
+
+// Operadores bit a bit: operandos inteiros (number.h)
+#define VM_BITWISE(operator) do { \
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) { \
+            status = NUMBER_NOT_INTEGER; \
+            goto number_error; \
+        } \
+        status = number_bitwise((operator), &sp[-2], sp[-1]); \
+        if (status != NUMBER_OK) goto number_error; \
+        sp--; \
+    } while (0)
+
+EvaluatorResult vm_execute(EvaluatorState* state, const Chunk* chunk) {
+    int base = state->stack_top;
+    if (!evaluator_reserve_stack(state, chunk->max_stack)) {
+        if (current_lang == LANG_PT)
+            return create_error_result(state, "Falha de alocação de memória");
+        else
+            return create_error_result(state, "Memory allocation failed");
+    }
+
+#ifdef VM_COMPUTED_GOTO
+    static void* const dispatch_table[OP_COUNT] = {
+        [OP_CONSTANT]  = &&label_OP_CONSTANT,
+        [OP_LOAD]      = &&label_OP_LOAD,
+        [OP_STORE]     = &&label_OP_STORE,
+        [OP_ADD]       = &&label_OP_ADD,
+        [OP_CONCAT]    = &&label_OP_CONCAT,
+        [OP_SUBTRACT]  = &&label_OP_SUBTRACT,
+        [OP_MULTIPLY]  = &&label_OP_MULTIPLY,
+        [OP_DIVIDE]    = &&label_OP_DIVIDE,
+        [OP_MODULO]    = &&label_OP_MODULO,
+        [OP_POWER]     = &&label_OP_POWER,
+        [OP_BIT_AND]   = &&label_OP_BIT_AND,
+        [OP_BIT_OR]    = &&label_OP_BIT_OR,
+        [OP_BIT_XOR]   = &&label_OP_BIT_XOR,
+        [OP_SHIFT_LEFT]  = &&label_OP_SHIFT_LEFT,
+        [OP_SHIFT_RIGHT] = &&label_OP_SHIFT_RIGHT,
+        [OP_NEGATE]    = &&label_OP_NEGATE,
+        [OP_FACTORIAL] = &&label_OP_FACTORIAL,
+        [OP_BIT_NOT]   = &&label_OP_BIT_NOT,
+        [OP_CALL]      = &&label_OP_CALL,
+        [OP_STATEMENT] = &&label_OP_STATEMENT,
+        [OP_RETURN]    = &&label_OP_RETURN,
+    };
+#endif
+
+    // A pilha não é realocada durante a execução (ver max_stack)
+    Value* stack = state->stack + base;
+    Value* sp = stack;
+    const unsigned int* ip = chunk->code;
+    const Value* constants = chunk->constants;
+    unsigned int instruction;
+
+    // Resultado de uma sequência (último statement impresso) e o
+    // is_assignment devolvido pela última função chamada
+    Value sequence_value = create_null_value();
+    int has_value = 0;
+    int call_silent = 0;
+    NumberStatus status;
+
+    VM_LOOP_BEGIN
+
+    VM_CASE(OP_CONSTANT) {
+        const Value* constant = &constants[OP_OPERAND(instruction)];
+        *sp++ = IS_NUMBER(*constant) ? *constant : value_retain(*constant);
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_LOAD) {
+        Value* slot = &state->slots[OP_OPERAND(instruction)];
+        if (IS_NUMBER(*slot)) {
+            *sp++ = *slot;
+            VM_NEXT();
+        }
+        if (slot->type == VAL_UNDEFINED) {
+            VM_ERROR("Variável não definida", "Variable not defined");
+        }
+        *sp++ = value_retain(*slot);
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_STORE) {
+        Value* slot = &state->slots[OP_OPERAND(instruction)];
+        RELEASE(slot);
+        *slot = IS_NUMBER(sp[-1]) ? sp[-1] : value_retain(sp[-1]);
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_ADD) {
+        Value* left = sp - 2;
+        Value* right = sp - 1;
+        if (IS_NUMBER(*left) && IS_NUMBER(*right)) {
+            if (BOTH_DOUBLE(*left, *right)) {
+                left->as.number += right->as.number;
+            } else {
+                number_add(left, *right);
+            }
+            sp--;
+            VM_NEXT();
+        }
+        // Qualquer operando não numérico: concatenação
+        EvaluatorResult left_result = create_success_result(*left, 0);
+        EvaluatorResult right_result = create_success_result(*right, 0);
+        EvaluatorResult concat = string_concatenate(&left_result, &right_result, -1);
+        value_release(left);
+        value_release(right);
+        *left = concat.value;
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_CONCAT) {
+        Value* parts = sp - OP_OPERAND(instruction);
+        Value concat = concatenate_values(parts, (int)OP_OPERAND(instruction), -1);
+        while (sp > parts) {
+            sp--;
+            RELEASE(sp);
+        }
+        *sp++ = concat;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_SUBTRACT) {
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) goto arithmetic_error;
+        if (BOTH_DOUBLE(sp[-2], sp[-1])) {
+            sp[-2].as.number -= sp[-1].as.number;
+        } else {
+            number_subtract(&sp[-2], sp[-1]);
+        }
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_MULTIPLY) {
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) goto arithmetic_error;
+        if (BOTH_DOUBLE(sp[-2], sp[-1])) {
+            sp[-2].as.number *= sp[-1].as.number;
+        } else {
+            number_multiply(&sp[-2], sp[-1]);
+        }
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_DIVIDE) {
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) goto arithmetic_error;
+        status = number_divide(&sp[-2], sp[-1]);
+        if (status != NUMBER_OK) goto number_error;
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_MODULO) {
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) goto arithmetic_error;
+        status = number_modulo(&sp[-2], sp[-1]);
+        if (status != NUMBER_OK) goto number_error;
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_POWER) {
+        if (!IS_NUMBER(sp[-2]) || !IS_NUMBER(sp[-1])) goto arithmetic_error;
+        number_power(&sp[-2], sp[-1]);
+        sp--;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_BIT_AND) {
+        VM_BITWISE('&');
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_BIT_OR) {
+        VM_BITWISE('|');
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_BIT_XOR) {
+        VM_BITWISE('~');
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_SHIFT_LEFT) {
+        VM_BITWISE('<');
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_SHIFT_RIGHT) {
+        VM_BITWISE('>');
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_NEGATE) {
+        if (!IS_NUMBER(sp[-1])) goto unary_error;
+        number_negate(&sp[-1]);
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_FACTORIAL) {
+        if (!IS_NUMBER(sp[-1])) goto unary_error;
+        number_factorial(&sp[-1]);
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_BIT_NOT) {
+        if (!IS_NUMBER(sp[-1])) goto unary_error;
+        status = number_bitwise_not(&sp[-1]);
+        if (status != NUMBER_OK) goto number_error;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_CALL) {
+        int arg_count = (int)*ip++;
+        Value* args = sp - arg_count;
+        EvaluatorResult call = execute_function(state, (int)OP_OPERAND(instruction),
+                                                args, arg_count);
+        while (sp > args) {
+            sp--;
+            RELEASE(sp);
+        }
+        if (!call.success) {
+            ip--;   // A posição do erro é a do OP_CALL
+            goto error;
+        }
+        *sp++ = call.value;
+        call_silent = call.is_assignment;
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_STATEMENT) {
+        unsigned int kind = OP_OPERAND(instruction);
+        sp--;
+        if (kind == RESULT_VALUE || (kind == RESULT_CALL && !call_silent)) {
+            RELEASE(&sequence_value);
+            sequence_value = *sp;
+            has_value = 1;
+        } else {
+            RELEASE(sp);
+        }
+        VM_NEXT();
+    }
+
+    VM_CASE(OP_RETURN) {
+        unsigned int kind = OP_OPERAND(instruction);
+        state->stack_top = base;
+        if (kind == RESULT_SEQUENCE) {
+            if (has_value) {
+                return create_success_result(sequence_value, 0);
+            }
+            // Só atribuições: sucesso sem valor
+            return create_success_result(create_null_value(), 1);
+        }
+        // Statement único: o topo é o único valor na pilha
+        return create_success_result(*--sp, kind == RESULT_ASSIGNMENT ||
+                                            (kind == RESULT_CALL && call_silent));
+    }
+
+    VM_LOOP_END
+
+#ifndef VM_COMPUTED_GOTO
+invalid_opcode:
+    create_error_result(state, current_lang == LANG_PT ? "Instrução inválida"
+                                                       : "Invalid instruction");
+    goto error;
+#endif
+
+arithmetic_error:
+    create_error_result(state, current_lang == LANG_PT ? "Operações aritméticas requerem números"
+                                                       : "Arithmetic operations require numbers");
+    goto error;
+
+unary_error:
+    create_error_result(state, current_lang == LANG_PT ? "Operações unárias requerem números"
+                                                       : "Unary operations require numbers");
+    goto error;
+
+number_error:
+    create_error_result(state, number_error_message(status));
+    goto error;
+
+error:
+    // A instrução que falhou é a última lida
+    if (state->error.position < 0) {
+        state->error.position = chunk->positions[ip - 1 - chunk->code];
+    }
+    while (sp > stack) {
+        sp--;
+        RELEASE(sp);
+    }
+    RELEASE(&sequence_value);
+    state->stack_top = base;
+
+    EvaluatorResult result;
+    result.success = 0;
+    result.is_assignment = 0;
+    result.value = create_null_value();
+    return result;
+}
@@ -0,0 +1,23 @@
+#ifndef VM_H
+#define VM_H
+
+#include "bytecode.h"
+#include "evaluator.h"
+
+/********************************************************************
+MÁQUINA VIRTUAL - RUDIS
+
+Executa um Chunk sobre a pilha de valores do EvaluatorState. A
+profundidade máxima é reservada antes de começar, então o laço de
+despacho não verifica limites nem aloca. Com GCC/Clang o despacho usa
+computed goto (um salto indireto por instrução); defina
+VM_NO_COMPUTED_GOTO para forçar o switch portável.
+
+O resultado e os erros seguem as mesmas regras de evaluate(): o
+EvaluatorResult pertence ao chamador e, em caso de erro, os detalhes
+ficam em state->error (com a posição do nó que gerou a instrução).
+********************************************************************/
+
+EvaluatorResult vm_execute(EvaluatorState* state, const Chunk* chunk);
+
+#endif // VM_H
@@ -0,0 +1,149 @@
+#include <stddef.h>
+
+#include "width.h"
+
+typedef struct {
+    unsigned int first;
+    unsigned int last;
+} CodeRange;
+
+// Largura 0: marcas combinantes e caracteres invisíveis (ordem crescente)
+static const CodeRange zero_width[] = {
+    { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x05BF, 0x05BF },
+    { 0x05C1, 0x05C2 }, { 0x05C4, 0x05C5 }, { 0x05C7, 0x05C7 }, { 0x0610, 0x061A },
+    { 0x064B, 0x065F }, { 0x0670, 0x0670 }, { 0x06D6, 0x06DC }, { 0x06DF, 0x06E4 },
+    { 0x06E7, 0x06E8 }, { 0x06EA, 0x06ED }, { 0x0711, 0x0711 }, { 0x0730, 0x074A },
+    { 0x0900, 0x0902 }, { 0x093A, 0x093A }, { 0x093C, 0x093C }, { 0x0941, 0x0948 },
+    { 0x094D, 0x094D }, { 0x0951, 0x0957 }, { 0x0962, 0x0963 }, { 0x0E31, 0x0E31 },
+    { 0x0E34, 0x0E3A }, { 0x0E47, 0x0E4E }, { 0x1160, 0x11FF }, { 0x1AB0, 0x1AFF },
+    { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F }, { 0x202A, 0x202E }, { 0x2060, 0x2064 },
+    { 0x20D0, 0x20FF }, { 0x302A, 0x302D }, { 0x3099, 0x309A }, { 0xFE00, 0xFE0F },
+    { 0xFE20, 0xFE2F }, { 0xFEFF, 0xFEFF }, { 0xE0001, 0xE0001 }, { 0xE0020, 0xE007F },
+    { 0xE0100, 0xE01EF },
+};
+
+// Largura 2: East Asian Wide e Fullwidth, incluindo emojis (ordem crescente)
+static const CodeRange double_width[] = {
+    { 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC },
+    { 0x23F0, 0x23F0 }, { 0x23F3, 0x23F3 }, { 0x25FD, 0x25FE }, { 0x2614, 0x2615 },
+    { 0x2648, 0x2653 }, { 0x267F, 0x267F }, { 0x2693, 0x2693 }, { 0x26A1, 0x26A1 },
+    { 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26CE, 0x26CE },
+    { 0x26D4, 0x26D4 }, { 0x26EA, 0x26EA }, { 0x26F2, 0x26F3 }, { 0x26F5, 0x26F5 },
+    { 0x26FA, 0x26FA }, { 0x26FD, 0x26FD }, { 0x2705, 0x2705 }, { 0x270A, 0x270B },
+    { 0x2728, 0x2728 }, { 0x274C, 0x274C }, { 0x274E, 0x274E }, { 0x2753, 0x2755 },
+    { 0x2757, 0x2757 }, { 0x2795, 0x2797 }, { 0x27B0, 0x27B0 }, { 0x27BF, 0x27BF },
+    { 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x3029 },
+    { 0x302E, 0x303E }, { 0x3041, 0x3098 }, { 0x309B, 0x33FF }, { 0x3400, 0x4DBF },
+    { 0x4E00, 0x9FFF }, { 0xA000, 0xA4CF }, { 0xA960, 0xA97F }, { 0xAC00, 0xD7A3 },
+    { 0xF900, 0xFAFF }, { 0xFE10, 0xFE19 }, { 0xFE30, 0xFE6F }, { 0xFF00, 0xFF60 },
+    { 0xFFE0, 0xFFE6 }, { 0x16FE0, 0x16FE4 }, { 0x17000, 0x18CFF }, { 0x1B000, 0x1B2FF },
+    { 0x1F004, 0x1F004 }, { 0x1F0CF, 0x1F0CF }, { 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A },
+    { 0x1F200, 0x1F202 }, { 0x1F210, 0x1F23B }, { 0x1F240, 0x1F248 }, { 0x1F250, 0x1F251 },
+    { 0x1F260, 0x1F265 }, { 0x1F300, 0x1F320 }, { 0x1F32D, 0x1F335 }, { 0x1F337, 0x1F37C },
+    { 0x1F37E, 0x1F393 }, { 0x1F3A0, 0x1F3CA }, { 0x1F3CF, 0x1F3D3 }, { 0x1F3E0, 0x1F3F0 },
+    { 0x1F3F4, 0x1F3F4 }, { 0x1F3F8, 0x1F43E }, { 0x1F440, 0x1F440 }, { 0x1F442, 0x1F4FC },
+    { 0x1F4FF, 0x1F53D }, { 0x1F54B, 0x1F54E }, { 0x1F550, 0x1F567 }, { 0x1F57A, 0x1F57A },
+    { 0x1F595, 0x1F596 }, { 0x1F5A4, 0x1F5A4 }, { 0x1F5FB, 0x1F64F }, { 0x1F680, 0x1F6C5 },
+    { 0x1F6CC, 0x1F6CC }, { 0x1F6D0, 0x1F6D2 }, { 0x1F6D5, 0x1F6D7 }, { 0x1F6EB, 0x1F6EC },
+    { 0x1F6F4, 0x1F6FC }, { 0x1F7E0, 0x1F7EB }, { 0x1F90C, 0x1F93A }, { 0x1F93C, 0x1F945 },
+    { 0x1F947, 0x1F9FF }, { 0x1FA70, 0x1FAFF }, { 0x20000, 0x2FFFD }, { 0x30000, 0x3FFFD },
+};
+
+#define RANGE_COUNT(table) ((int)(sizeof(table) / sizeof((table)[0])))
+
+static int in_table(unsigned int code, const CodeRange* table, int count) {
+    if (code < table[0].first || code > table[count - 1].last) return 0;
+
+    int low = 0;
+    int high = count - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (code > table[middle].last) {
+            low = middle + 1;
+        } else if (code < table[middle].first) {
+            high = middle - 1;
+        } else {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int code_width(unsigned int code) {
+    if (code < 0x300) return (code >= 0x80 && code < 0xA0) ? 0 : 1;    // Controles C1
+    if (in_table(code, zero_width, RANGE_COUNT(zero_width))) return 0;
+    if (in_table(code, double_width, RANGE_COUNT(double_width))) return 2;
+    return 1;
+}
+
+// Decodifica um caractere multibyte em text[0..available); devolve o
+// número de bytes ou 0 se a sequência for inválida
+static int decode_utf8(const unsigned char* text, int available, unsigned int* code) {
+    unsigned char lead = text[0];
+    int size;
+    unsigned int minimum;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        size = 2;
+        *code = lead & 0x1F;
+        minimum = 0x80;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        size = 3;
+        *code = lead & 0x0F;
+        minimum = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        size = 4;
+        *code = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        return 0;
+    }
+
+    if (size > available) return 0;
+    for (int i = 1; i < size; i++) {
+        if ((text[i] & 0xC0) != 0x80) return 0;
+        *code = (*code << 6) | (text[i] & 0x3F);
+    }
+    if (*code < minimum || *code > 0x10FFFF) return 0;
+    return size;
+}
+
+int text_display_width(const char* text, int length) {
+    const unsigned char* bytes = (const unsigned char*)text;
+    int width = 0;
+    int i = 0;
+
+    while (i < length) {
+        unsigned char byte = bytes[i];
+
+        // ASCII comum: uma coluna por byte
+        if (byte < 0x80 && byte != 0x1B) {
+            width++;
+            i++;
+            continue;
+        }
+
+        // Sequência CSI: ESC [ parâmetros letra-final (0x40..0x7E)
+        if (byte == 0x1B) {
+            if (i + 1 < length && bytes[i + 1] == '[') {
+                i += 2;
+                while (i < length && (bytes[i] < 0x40 || bytes[i] > 0x7E)) i++;
+                if (i < length) i++;
+            } else {
+                i++;
+            }
+            continue;
+        }
+
+        unsigned int code;
+        int size = decode_utf8(bytes + i, length - i, &code);
+        if (size == 0) {
+            width++;        // Byte inválido
+            i++;
+            continue;
+        }
+        width += code_width(code);
+        i += size;
+    }
+    return width;
+}
@@ -0,0 +1,19 @@
+#ifndef WIDTH_H
+#define WIDTH_H
+
+/********************************************************************
+LARGURA DE EXIBIÇÃO - RUDIS
+
+Quantas colunas um texto UTF-8 ocupa no terminal, em uma passada:
+- sequências ANSI (ESC [ ... letra) não ocupam colunas;
+- marcas combinantes (acentos separados, seletores de variação,
+  caracteres de largura zero) ocupam 0;
+- ideogramas, hangul, kana, formas de largura cheia e emojis (East
+  Asian Wide/Fullwidth) ocupam 2;
+- o resto ocupa 1 ("ç", "ã" e "é" já compostos contam 1, não 2).
+Bytes UTF-8 inválidos contam 1 cada, como antes.
+********************************************************************/
+
+int text_display_width(const char* text, int length);
+
+#endif // WIDTH_H